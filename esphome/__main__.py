@@ -128,6 +128,9 @@ def run_miniterm(config, port):
         return 1
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
+    from esphome.components.logger import tokenizer
+
+    tokens = tokenizer.load_build_dictionary(config)
     backtrace_state = False
     ser = serial.Serial()
     ser.baudrate = baud_rate
@@ -154,6 +157,7 @@ def run_miniterm(config, port):
                         .replace(b"\n", b"")
                         .decode("utf8", "backslashreplace")
                     )
+                    line = tokenizer.decode_serial_line(line, tokens) or line
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
@@ -1,6 +1,7 @@
 #include "adc_sensor.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include <cinttypes>
 
 #ifdef USE_ESP8266
 #ifdef USE_ADC_SENSOR_VCC
@@ -39,6 +40,19 @@ static const int ADC_MAX = (1 << SOC_ADC_RTC_MAX_BITWIDTH) - 1;    // 4095 (12 b
 static const int ADC_HALF = (1 << SOC_ADC_RTC_MAX_BITWIDTH) >> 1;  // 2048 (12 bit) or 4096 (13 bit)
 #endif
 
+#ifdef USE_ADC_CONTINUOUS
+// Conversion results are in type 1 format (2 bytes) on the ESP32, type 2 (4 bytes) on the S3 and C3
+#ifdef USE_ESP32_VARIANT_ESP32
+static const size_t CONTINUOUS_RESULT_BYTES = 2;
+#else
+static const size_t CONTINUOUS_RESULT_BYTES = 4;
+#endif
+static const size_t CONTINUOUS_FRAME_SAMPLES = 256;
+static const size_t CONTINUOUS_FRAME_BYTES = CONTINUOUS_FRAME_SAMPLES * CONTINUOUS_RESULT_BYTES;
+// Frames the driver buffers between two loop() calls, 51ms at 20 kHz
+static const size_t CONTINUOUS_FRAMES = 4;
+#endif
+
 #ifdef USE_RP2040
 extern "C"
 #endif
@@ -50,14 +64,17 @@ extern "C"
 #endif
 
 #ifdef USE_ESP32
-  if (this->channel1_ != ADC1_CHANNEL_MAX) {
-    adc1_config_width(ADC_WIDTH_MAX_SOC_BITS);
-    if (!this->autorange_) {
-      adc1_config_channel_atten(this->channel1_, this->attenuation_);
-    }
-  } else if (this->channel2_ != ADC2_CHANNEL_MAX) {
-    if (!this->autorange_) {
-      adc2_config_channel_atten(this->channel2_, this->attenuation_);
+  // In continuous mode the channel is configured by setup_continuous_()
+  if (!this->is_continuous()) {
+    if (this->channel1_ != ADC1_CHANNEL_MAX) {
+      adc1_config_width(ADC_WIDTH_MAX_SOC_BITS);
+      if (!this->autorange_) {
+        adc1_config_channel_atten(this->channel1_, this->attenuation_);
+      }
+    } else if (this->channel2_ != ADC2_CHANNEL_MAX) {
+      if (!this->autorange_) {
+        adc2_config_channel_atten(this->channel2_, this->attenuation_);
+      }
     }
   }
 
@@ -80,6 +97,15 @@ extern "C"
     }
   }
 
+#ifdef USE_ADC_CONTINUOUS
+  if (this->is_continuous()) {
+    this->setup_continuous_();
+    if (this->is_failed())
+      return;
+  } else {
+    this->disable_loop();
+  }
+#endif
 #endif  // USE_ESP32
 
 #ifdef USE_RP2040
@@ -139,11 +165,31 @@ void ADCSensor::dump_config() {
   }
 #endif  // USE_RP2040
   ESP_LOGCONFIG(TAG, "  Samples: %i", this->sample_count_);
+#ifdef USE_ADC_CONTINUOUS
+  if (this->is_continuous()) {
+    ESP_LOGCONFIG(TAG, "  Continuous: %" PRIu32 " Hz", this->sample_rate_);
+  }
+#endif
   LOG_UPDATE_INTERVAL(this);
 }
 
 float ADCSensor::get_setup_priority() const { return setup_priority::DATA; }
 void ADCSensor::update() {
+#ifdef USE_ADC_CONTINUOUS
+  if (this->is_continuous()) {
+    float value = this->aggregator_.get(this->aggregate_);
+    ESP_LOGV(TAG, "'%s': Got %.4f from %" PRIu32 " samples", this->get_name().c_str(), value,
+             this->aggregator_.count());
+    if (this->overruns_ != 0) {
+      ESP_LOGW(TAG, "'%s': Samples lost %" PRIu32 " times, the loop is too slow for the sample rate",
+               this->get_name().c_str(), this->overruns_);
+      this->overruns_ = 0;
+    }
+    this->aggregator_.reset();
+    this->publish_state(value);
+    return;
+  }
+#endif
   float value_v = this->sample();
   ESP_LOGV(TAG, "'%s': Got voltage=%.4fV", this->get_name().c_str(), value_v);
   this->publish_state(value_v);
@@ -175,6 +221,10 @@ float ADCSensor::sample() {
 
 #ifdef USE_ESP32
 float ADCSensor::sample() {
+#ifdef USE_ADC_CONTINUOUS
+  if (this->is_continuous())
+    return this->last_sample_;
+#endif
   if (!this->autorange_) {
     uint32_t sum = 0;
     for (uint8_t sample = 0; sample < this->sample_count_; sample++) {
@@ -254,6 +304,96 @@ float ADCSensor::sample() {
 }
 #endif  // USE_ESP32
 
+#ifdef USE_ADC_CONTINUOUS
+void ADCSensor::setup_continuous_() {
+  adc_digi_init_config_t init_config{};
+  init_config.max_store_buf_size = CONTINUOUS_FRAME_BYTES * CONTINUOUS_FRAMES;
+  init_config.conv_num_each_intr = CONTINUOUS_FRAME_BYTES;
+  init_config.adc1_chan_mask = 1 << this->channel1_;
+  init_config.adc2_chan_mask = 0;
+  esp_err_t err = adc_digi_initialize(&init_config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Initializing continuous mode failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return;
+  }
+
+  adc_digi_pattern_config_t pattern{};
+  pattern.atten = this->attenuation_;
+  pattern.channel = this->channel1_;
+  pattern.unit = 0;  // ADC1
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_digi_configuration_t config{};
+  config.pattern_num = 1;
+  config.adc_pattern = &pattern;
+  config.sample_freq_hz = this->sample_rate_;
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+#ifdef USE_ESP32_VARIANT_ESP32
+  // Required on the ESP32, the limit only ends a conversion sequence that the single pattern ends anyway
+  config.conv_limit_en = true;
+  config.conv_limit_num = 250;
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+#else
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+#endif
+  err = adc_digi_controller_configure(&config);
+  if (err == ESP_OK)
+    err = adc_digi_start();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Starting continuous mode failed: %s", esp_err_to_name(err));
+    adc_digi_deinitialize();
+    this->mark_failed();
+    return;
+  }
+
+  this->frame_.reset(new uint8_t[CONTINUOUS_FRAME_BYTES]);     // NOLINT(cppcoreguidelines-owning-memory)
+  this->samples_.reset(new float[CONTINUOUS_FRAME_SAMPLES]);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+void ADCSensor::loop() {
+  const auto *cal_characteristics = &this->cal_characteristics_[(int32_t) this->attenuation_];
+  // Bounded, so that a sample rate the loop can't keep up with doesn't block it
+  for (size_t frame = 0; frame < CONTINUOUS_FRAMES; frame++) {
+    uint32_t length = 0;
+    esp_err_t err = adc_digi_read_bytes(this->frame_.get(), CONTINUOUS_FRAME_BYTES, &length, 0);
+    if (err == ESP_ERR_INVALID_STATE) {
+      // The driver buffer overflowed, the frame read is still valid
+      this->overruns_++;
+    } else if (err != ESP_OK) {
+      break;
+    }
+    if (length == 0)
+      break;
+
+    size_t count = 0;
+    for (uint32_t i = 0; i + CONTINUOUS_RESULT_BYTES <= length; i += CONTINUOUS_RESULT_BYTES) {
+      const auto *result = reinterpret_cast<const adc_digi_output_data_t *>(&this->frame_[i]);
+#ifdef USE_ESP32_VARIANT_ESP32
+      uint32_t channel = result->type1.channel;
+      uint32_t raw = result->type1.data;
+#else
+      uint32_t channel = result->type2.channel;
+      uint32_t raw = result->type2.data;
+#endif
+      if (channel != (uint32_t) this->channel1_)
+        continue;
+      if (this->output_raw_) {
+        this->samples_[count++] = raw;
+      } else {
+        this->samples_[count++] = esp_adc_cal_raw_to_voltage(raw, cal_characteristics) / 1000.0f;
+      }
+    }
+    if (count == 0)
+      continue;
+
+    this->aggregator_.add(this->samples_.get(), count);
+    this->last_sample_ = this->samples_[count - 1];
+    this->samples_callback_.call(this->samples_.get(), count);
+  }
+}
+#endif  // USE_ADC_CONTINUOUS
+
 #ifdef USE_RP2040
 float ADCSensor::sample() {
   if (this->is_temperature_) {
@@ -5,6 +5,11 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/hal.h"
+#include "sample_aggregator.h"
+
+#ifdef USE_ADC_CONTINUOUS
+#include <memory>
+#endif
 
 #ifdef USE_ESP32
 #include <esp_adc_cal.h>
@@ -45,6 +50,19 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   void set_autorange(bool autorange) { this->autorange_ = autorange; }
 #endif
 
+#ifdef USE_ADC_CONTINUOUS
+  /** Sample continuously at `sample_rate` Hz instead of once per update.
+   *
+   * The ADC converts on its own and DMA fills a ring of frames, which loop() drains. Every update publishes the
+   * aggregate of the samples since the previous one, and the samples are passed to the sample callbacks in blocks.
+   * Only one ADC1 channel at a time.
+   */
+  void set_continuous(uint32_t sample_rate) { this->sample_rate_ = sample_rate; }
+  void set_aggregate(SampleAggregate aggregate) { this->aggregate_ = aggregate; }
+  bool is_continuous() const override { return this->sample_rate_ != 0; }
+  void loop() override;
+#endif
+
   /// Update ADC values
   void update() override;
   /// Setup ADC
@@ -74,6 +92,18 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   bool is_temperature_{false};
 #endif
 
+#ifdef USE_ADC_CONTINUOUS
+  void setup_continuous_();
+
+  uint32_t sample_rate_{0};  ///< 0 when sampling once per update
+  SampleAggregate aggregate_{SampleAggregate::MEAN};
+  SampleAggregator aggregator_;
+  std::unique_ptr<uint8_t[]> frame_;   ///< A DMA frame as read from the driver
+  std::unique_ptr<float[]> samples_;  ///< The converted samples of frame_
+  float last_sample_{NAN};
+  uint32_t overruns_{0};  ///< Number of times samples were lost because the driver buffer was full
+#endif
+
 #ifdef USE_ESP32
   adc_atten_t attenuation_{ADC_ATTEN_DB_0};
   adc1_channel_t channel1_{ADC1_CHANNEL_MAX};
@@ -0,0 +1,82 @@
+#include "sample_aggregator.h"
+#include <algorithm>
+
+namespace esphome {
+namespace adc {
+
+void SampleAggregator::add(const float *samples, size_t count) {
+  if (count == 0)
+    return;
+  if (this->count_ == 0) {
+    this->shift_ = samples[0];
+    this->min_ = samples[0];
+    this->max_ = samples[0];
+  }
+  const float shift = this->shift_;
+  float sum = 0.0f;
+  float squared_sum = 0.0f;
+  float min = this->min_;
+  float max = this->max_;
+  for (size_t i = 0; i < count; i++) {
+    const float value = samples[i] - shift;
+    sum += value;
+    squared_sum += value * value;
+    min = std::min(min, samples[i]);
+    max = std::max(max, samples[i]);
+  }
+  this->sum_ += sum;
+  this->squared_sum_ += squared_sum;
+  this->min_ = min;
+  this->max_ = max;
+  this->count_ += count;
+}
+
+void SampleAggregator::reset() {
+  this->count_ = 0;
+  this->sum_ = 0.0;
+  this->squared_sum_ = 0.0;
+}
+
+float SampleAggregator::mean() const {
+  if (this->count_ == 0)
+    return NAN;
+  return this->shift_ + this->sum_ / this->count_;
+}
+
+float SampleAggregator::ac_rms() const {
+  if (this->count_ == 0)
+    return NAN;
+  const double mean = this->sum_ / this->count_;
+  const double variance = this->squared_sum_ / this->count_ - mean * mean;
+  return variance > 0.0 ? std::sqrt(variance) : 0.0f;
+}
+
+float SampleAggregator::rms() const {
+  if (this->count_ == 0)
+    return NAN;
+  const double ac_rms = this->ac_rms();
+  const double mean = this->mean();
+  return std::sqrt(ac_rms * ac_rms + mean * mean);
+}
+
+float SampleAggregator::get(SampleAggregate aggregate) const {
+  switch (aggregate) {
+    case SampleAggregate::MEAN:
+      return this->mean();
+    case SampleAggregate::RMS:
+      return this->rms();
+    case SampleAggregate::AC_RMS:
+      return this->ac_rms();
+    case SampleAggregate::MIN:
+      return this->min();
+    case SampleAggregate::MAX:
+      return this->max();
+    case SampleAggregate::PEAK_TO_PEAK:
+      return this->max() - this->min();
+    default:
+      return NAN;
+  }
+}
+
+}  // namespace adc
+}  // namespace esphome
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace adc {
+
+enum class SampleAggregate : uint8_t {
+  MEAN,
+  RMS,
+  AC_RMS,  ///< RMS with the mean (DC offset) removed, the standard deviation
+  MIN,
+  MAX,
+  PEAK_TO_PEAK,
+};
+
+/** Running statistics over blocks of samples, like the frames of an ADC in continuous mode.
+ *
+ * Each block is summed in single precision, which costs far less than double precision on every ESP32 variant, and
+ * only the block sums are added to double precision totals. That keeps the error of long windows (minutes of samples at
+ * several kHz) low while the cost per sample stays a few float operations. The samples are summed relative to the first
+ * one, so that a large DC offset, like the mid-supply bias of a current clamp, does not drown the AC part in rounding
+ * errors.
+ */
+class SampleAggregator {
+ public:
+  /// Add a block of samples.
+  void add(const float *samples, size_t count);
+  /// Forget all samples added so far.
+  void reset();
+
+  uint32_t count() const { return this->count_; }
+  /// The requested aggregate of the samples added since the last reset(), NaN if there are none.
+  float get(SampleAggregate aggregate) const;
+
+  float mean() const;
+  float rms() const;
+  float ac_rms() const;
+  float min() const { return this->count_ == 0 ? NAN : this->min_; }
+  float max() const { return this->count_ == 0 ? NAN : this->max_; }
+
+ protected:
+  uint32_t count_{0};
+  float shift_{0.0f};        ///< First sample since the last reset, subtracted from all samples
+  double sum_{0.0};          ///< Sum of the shifted samples
+  double squared_sum_{0.0};  ///< Sum of the squares of the shifted samples
+  float min_{0.0f};
+  float max_{0.0f};
+};
+
+}  // namespace adc
+}  // namespace esphome
@@ -6,12 +6,18 @@ import esphome.final_validate as fv
 from esphome.core import CORE
 from esphome.components import sensor, voltage_sampler
 from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import (
+    VARIANT_ESP32,
+    VARIANT_ESP32C3,
+    VARIANT_ESP32S3,
+)
 from esphome.const import (
     CONF_ATTENUATION,
     CONF_ID,
     CONF_NUMBER,
     CONF_PIN,
     CONF_RAW,
+    CONF_SAMPLE_RATE,
     CONF_WIFI,
     DEVICE_CLASS_VOLTAGE,
     STATE_CLASS_MEASUREMENT,
@@ -30,6 +36,26 @@ _LOGGER = logging.getLogger(__name__)
 AUTO_LOAD = ["voltage_sampler"]
 
 CONF_SAMPLES = "samples"
+CONF_CONTINUOUS = "continuous"
+CONF_AGGREGATE = "aggregate"
+
+SampleAggregate = adc_ns.enum("SampleAggregate", is_class=True)
+SAMPLE_AGGREGATES = {
+    "mean": SampleAggregate.MEAN,
+    "rms": SampleAggregate.RMS,
+    "ac_rms": SampleAggregate.AC_RMS,
+    "min": SampleAggregate.MIN,
+    "max": SampleAggregate.MAX,
+    "peak_to_peak": SampleAggregate.PEAK_TO_PEAK,
+}
+
+# Variants with DMA for ADC1 in the legacy ADC driver, with their lowest sample rate
+CONTINUOUS_MIN_SAMPLE_RATE = {
+    VARIANT_ESP32: 20000,
+    VARIANT_ESP32C3: 611,
+    VARIANT_ESP32S3: 611,
+}
+CONTINUOUS_MAX_SAMPLE_RATE = 83333
 
 
 _attenuation = cv.enum(ATTENUATION_MODES, lower=True)
@@ -43,6 +69,11 @@ def validate_config(config):
         raise cv.Invalid(
             "Automatic attenuation cannot be used when multisampling is set"
         )
+    if CONF_CONTINUOUS in config:
+        if config.get(CONF_ATTENUATION, None) == "auto":
+            raise cv.Invalid("Automatic attenuation cannot be used in continuous mode")
+        if config.get(CONF_SAMPLES, 1) > 1:
+            raise cv.Invalid("Multisampling cannot be used in continuous mode")
     if config.get(CONF_ATTENUATION) == "11db":
         _LOGGER.warning(
             "`attenuation: 11db` is deprecated, use `attenuation: 12db` instead"
@@ -65,6 +96,38 @@ def final_validate_config(config):
                 f"{variant} doesn't support ADC on this pin when Wi-Fi is configured"
             )
 
+    if continuous := config.get(CONF_CONTINUOUS):
+        variant = get_esp32_variant()
+        if variant not in CONTINUOUS_MIN_SAMPLE_RATE:
+            raise cv.Invalid(
+                f"{variant} doesn't support continuous mode",
+                path=[CONF_CONTINUOUS],
+            )
+        if (
+            config[CONF_PIN][CONF_NUMBER]
+            not in ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[variant]
+        ):
+            raise cv.Invalid(
+                "Continuous mode is only supported on ADC1 pins",
+                path=[CONF_CONTINUOUS],
+            )
+        min_rate = CONTINUOUS_MIN_SAMPLE_RATE[variant]
+        if continuous[CONF_SAMPLE_RATE] < min_rate:
+            raise cv.Invalid(
+                f"{variant} needs a sample rate of at least {min_rate} Hz",
+                path=[CONF_CONTINUOUS, CONF_SAMPLE_RATE],
+            )
+        count = sum(
+            1
+            for conf in fv.full_config.get().get("sensor", [])
+            if conf.get("platform") == "adc" and CONF_CONTINUOUS in conf
+        )
+        if count > 1:
+            raise cv.Invalid(
+                "Only one ADC sensor can use continuous mode",
+                path=[CONF_CONTINUOUS],
+            )
+
     return config
 
 
@@ -88,6 +151,21 @@ CONFIG_SCHEMA = cv.All(
                 cv.only_on_esp32, _attenuation
             ),
             cv.Optional(CONF_SAMPLES, default=1): cv.int_range(min=1, max=255),
+            cv.Optional(CONF_CONTINUOUS): cv.All(
+                cv.only_on_esp32,
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_SAMPLE_RATE, default="20kHz"): cv.All(
+                            cv.frequency,
+                            cv.float_range(max=CONTINUOUS_MAX_SAMPLE_RATE),
+                            int,
+                        ),
+                        cv.Optional(CONF_AGGREGATE, default="mean"): cv.enum(
+                            SAMPLE_AGGREGATES, lower=True
+                        ),
+                    }
+                ),
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s")),
@@ -113,6 +191,11 @@ async def to_code(config):
     cg.add(var.set_output_raw(config[CONF_RAW]))
     cg.add(var.set_sample_count(config[CONF_SAMPLES]))
 
+    if continuous := config.get(CONF_CONTINUOUS):
+        cg.add_define("USE_ADC_CONTINUOUS")
+        cg.add(var.set_continuous(continuous[CONF_SAMPLE_RATE]))
+        cg.add(var.set_aggregate(continuous[CONF_AGGREGATE]))
+
     if attenuation := config.get(CONF_ATTENUATION):
         if attenuation == "auto":
             cg.add(var.set_autorange(cg.global_ns.true))
@@ -1,6 +1,7 @@
 import base64
+import hashlib
 
-from esphome import automation
+from esphome import automation, yaml_util
 from esphome.automation import Condition
 import esphome.codegen as cg
 import esphome.config_validation as cv
@@ -22,8 +23,9 @@ from esphome.const import (
     CONF_TAG,
     CONF_TRIGGER_ID,
     CONF_VARIABLES,
+    __version__,
 )
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, coroutine_with_priority
 
 DEPENDENCIES = ["network"]
 AUTO_LOAD = ["socket"]
@@ -49,6 +51,7 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
 
 
 def validate_encryption_key(value):
@@ -91,6 +94,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_BATCH_DELAY, default="0ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+            ),
             cv.Exclusive(
                 CONF_SERVICES, group_of_exclusion=CONF_ACTIONS
             ): ACTIONS_SCHEMA,
@@ -112,6 +119,17 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _config_hash():
+    """Hash of everything the entity list depends on.
+
+    Lets clients reuse a cached entity list and states.
+    """
+    content = f"{__version__}\n{yaml_util.dump(CORE.config)}"
+    value = int.from_bytes(hashlib.sha256(content.encode()).digest()[:4], "little")
+    # 0 means "no hash" in the protocol
+    return value or 1
+
+
 @coroutine_with_priority(40.0)
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -120,6 +138,8 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
+    cg.add(var.set_config_hash(_config_hash()))
 
     for conf in config.get(CONF_ACTIONS, []):
         template_args = []
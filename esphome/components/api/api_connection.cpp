@@ -27,6 +27,10 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+// Bytes sent per state batch write, roughly what fits into a single TCP segment
+static const size_t MAX_STATE_BATCH_SIZE = 1360;
+// How often clients that subscribed to state generations are told the current one
+static const uint32_t STATE_GENERATION_INTERVAL = 10000;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -95,6 +99,7 @@ void APIConnection::loop() {
   }
   ReadPacketBuffer buffer;
   err = this->helper_->read_packet(&buffer);
+  bool received = err == APIError::OK;
   if (err == APIError::WOULD_BLOCK) {
     // pass
   } else if (err != APIError::OK) {
@@ -111,13 +116,23 @@ void APIConnection::loop() {
   } else {
     this->last_traffic_ = millis();
     // read a packet
-    this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    this->read_message(buffer.data_len, buffer.type, buffer.data);
     if (this->remove_)
       return;
   }
 
   this->list_entities_iterator_.advance();
+  this->sending_initial_states_ = true;
   this->initial_state_iterator_.advance();
+  this->sending_initial_states_ = false;
+
+  if (!this->state_batch_.empty() && millis() - this->state_batch_start_ >= this->parent_->get_batch_delay())
+    this->send_state_batch_();
+
+  if (this->initial_states_sent_ && this->state_generation_subscription_ &&
+      this->state_generation_sent_ != this->parent_->get_state_generation() &&
+      millis() - this->state_generation_sent_at_ >= STATE_GENERATION_INTERVAL)
+    this->send_state_generation_();
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -152,7 +167,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // key (5 bytes), data (up to 4 bytes of key and length), done (2 bytes)
+    auto buffer = this->create_buffer(to_send + 11);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -186,12 +202,142 @@ void APIConnection::loop() {
       }
     }
   }
+
+#ifdef USE_TICKLESS_LOOP
+  // Packets from the client wake the loop through the socket. Keepalives and state generations are due after seconds,
+  // the loop sleeps at most one.
+  this->idle_ = !received && this->list_entities_iterator_.completed() && this->initial_state_iterator_.completed() &&
+                this->state_batch_.empty() && this->state_subs_at_ == -1 && this->helper_->can_write_without_blocking();
+#ifdef USE_ESP32_CAMERA
+  this->idle_ &= !this->image_reader_.available();
+#endif
+#endif
 }
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
 }
 
+/// Whether every change of a state matters to the client, like the edges of a binary sensor. A batch only sends the
+/// newest state of an entity, so these are never batched.
+static bool is_edge_sensitive(uint16_t message_type) {
+  switch (message_type) {
+    case BinarySensorStateResponse::MESSAGE_TYPE:
+    case SwitchStateResponse::MESSAGE_TYPE:
+    case LockStateResponse::MESSAGE_TYPE:
+    case AlarmControlPanelStateResponse::MESSAGE_TYPE:
+    // Text sensors often report events, like a received code, where every value counts
+    case TextSensorStateResponse::MESSAGE_TYPE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool APIConnection::send_state_(EntityBase *entity, StateEncoder encoder, uint16_t message_type) {
+  if (!this->state_subscription_)
+    return false;
+
+  if (this->parent_->get_batch_delay() == 0 || is_edge_sensitive(message_type)) {
+    // State messages are small, the buffer keeps its capacity between messages
+    auto buffer = this->create_buffer(0);
+    this->parent_->encode_state(entity, encoder, message_type, buffer);
+    if (this->send_buffer(buffer, message_type))
+      return true;
+    // The initial state iterator retries, but a live state change is lost
+    if (!this->sending_initial_states_)
+      this->state_dropped_ = true;
+    return false;
+  }
+
+  for (auto &item : this->state_batch_) {
+    // Already queued, the state is read when the batch is sent so the newest value goes out
+    if (item.entity == entity && item.message_type == message_type)
+      return true;
+  }
+  if (this->state_batch_.empty()) {
+    this->state_batch_start_ = millis();
+#ifdef USE_TICKLESS_LOOP
+    // The batch is sent by loop(), which may have reported idle already
+    App.wake_loop_any_context();
+#endif
+  }
+  this->state_batch_.push_back({entity, encoder, message_type});
+  return true;
+}
+
+void APIConnection::send_state_batch_() {
+  if (this->remove_ || !this->helper_->can_write_without_blocking())
+    return;  // try again on the next loop
+
+  auto buffer = this->create_buffer(MAX_STATE_BATCH_SIZE);
+  const uint8_t header_padding = this->helper_->frame_header_padding();
+  const uint8_t footer_size = this->helper_->frame_footer_size();
+  this->state_batch_packets_.clear();
+  size_t count = 0;
+  for (auto &item : this->state_batch_) {
+    // create_buffer() already left room for the header of the first message
+    if (count != 0)
+      this->proto_write_buffer_.resize(this->proto_write_buffer_.size() + header_padding);
+    size_t offset = this->proto_write_buffer_.size();
+    this->parent_->encode_state(item.entity, item.encoder, item.message_type, buffer);
+    this->state_batch_packets_.push_back({item.message_type, static_cast<uint16_t>(offset),
+                                          static_cast<uint32_t>(this->proto_write_buffer_.size() - offset)});
+    this->proto_write_buffer_.resize(this->proto_write_buffer_.size() + footer_size);
+    count++;
+    // Leave the rest for the next loop, no matter how long the batch delay is
+    if (this->proto_write_buffer_.size() >= MAX_STATE_BATCH_SIZE)
+      break;
+  }
+
+  ESP_LOGVV(TAG, "Sending %zu state messages (%zu bytes)", count, this->proto_write_buffer_.size());
+  APIError err = this->helper_->write_packets(this->proto_write_buffer_.data(), this->state_batch_packets_);
+  if (!this->handle_write_result_(err))
+    return;
+  this->state_batch_.erase(this->state_batch_.begin(), this->state_batch_.begin() + count);
+}
+
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  this->state_generation_subscription_ = msg.config_hash != 0;
+  this->initial_states_sent_ = false;
+  this->state_dropped_ = false;
+  if (msg.config_hash == this->parent_->get_config_hash() && msg.state_epoch == this->parent_->get_state_epoch() &&
+      msg.state_generation <= this->parent_->get_state_generation()) {
+    ESP_LOGD(TAG, "%s: Sending states changed since generation %" PRIu32, this->client_combined_info_.c_str(),
+             msg.state_generation);
+    this->initial_state_iterator_.set_since_generation(msg.state_generation);
+  } else {
+    this->initial_state_iterator_.set_since_generation({});
+  }
+  this->initial_state_iterator_.begin();
+}
+
+bool APIConnection::send_initial_states_done() {
+  if (this->state_generation_subscription_ && !this->send_state_generation_())
+    return false;
+  this->initial_states_sent_ = true;
+  return true;
+}
+
+bool APIConnection::send_state_generation_() {
+  if (this->state_dropped_)
+    return true;  // the client keeps using the last generation it got
+  // Queued state changes belong to the current generation, they have to go out first
+  if (!this->state_batch_.empty())
+    return false;
+
+  StateGenerationResponse resp;
+  resp.config_hash = this->parent_->get_config_hash();
+  resp.state_epoch = this->parent_->get_state_epoch();
+  resp.state_generation = this->parent_->get_state_generation();
+  if (!this->send_state_generation_response(resp))
+    return false;
+  this->state_generation_sent_ = resp.state_generation;
+  this->state_generation_sent_at_ = millis();
+  return true;
+}
+
 DisconnectResponse APIConnection::disconnect(const DisconnectRequest &msg) {
   // remote initiated disconnect_client
   // don't close yet, we still need to send the disconnect response
@@ -206,15 +352,16 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 }
 
 #ifdef USE_BINARY_SENSOR
-bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_binary_sensor_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *binary_sensor = static_cast<binary_sensor::BinarySensor *>(entity);
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
-  resp.state = state;
+  resp.state = binary_sensor->state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor) {
+  return this->send_state_(binary_sensor, &encode_binary_sensor_state, BinarySensorStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -233,10 +380,8 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 #endif
 
 #ifdef USE_COVER
-bool APIConnection::send_cover_state(cover::Cover *cover) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_cover_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *cover = static_cast<cover::Cover *>(entity);
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
   resp.key = cover->get_object_id_hash();
@@ -246,7 +391,10 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_cover_state(cover::Cover *cover) {
+  return this->send_state_(cover, &encode_cover_state, CoverStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -296,10 +444,8 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 #endif
 
 #ifdef USE_FAN
-bool APIConnection::send_fan_state(fan::Fan *fan) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_fan_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *fan = static_cast<fan::Fan *>(entity);
   auto traits = fan->get_traits();
   FanStateResponse resp{};
   resp.key = fan->get_object_id_hash();
@@ -313,7 +459,10 @@ bool APIConnection::send_fan_state(fan::Fan *fan) {
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
   if (traits.supports_preset_modes())
     resp.preset_mode = fan->preset_mode;
-  return this->send_fan_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_fan_state(fan::Fan *fan) {
+  return this->send_state_(fan, &encode_fan_state, FanStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
@@ -357,10 +506,8 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 #endif
 
 #ifdef USE_LIGHT
-bool APIConnection::send_light_state(light::LightState *light) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_light_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *light = static_cast<light::LightState *>(entity);
   auto traits = light->get_traits();
   auto values = light->remote_values;
   auto color_mode = values.get_color_mode();
@@ -380,7 +527,10 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_light_state(light::LightState *light) {
+  return this->send_state_(light, &encode_light_state, LightStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -455,15 +605,16 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 #endif
 
 #ifdef USE_SENSOR
-bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_sensor_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *sensor = static_cast<sensor::Sensor *>(entity);
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
-  resp.state = state;
+  resp.state = sensor->state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_sensor_state(sensor::Sensor *sensor) {
+  return this->send_state_(sensor, &encode_sensor_state, SensorStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -487,14 +638,15 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 #endif
 
 #ifdef USE_SWITCH
-bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_switch_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *a_switch = static_cast<switch_::Switch *>(entity);
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
-  resp.state = state;
-  return this->send_switch_state_response(resp);
+  resp.state = a_switch->state;
+  resp.encode(buffer);
+}
+bool APIConnection::send_switch_state(switch_::Switch *a_switch) {
+  return this->send_state_(a_switch, &encode_switch_state, SwitchStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -524,15 +676,16 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT_SENSOR
-bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_text_sensor_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *text_sensor = static_cast<text_sensor::TextSensor *>(entity);
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = text_sensor->state;
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor) {
+  return this->send_state_(text_sensor, &encode_text_sensor_state, TextSensorStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -551,10 +704,8 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 #endif
 
 #ifdef USE_CLIMATE
-bool APIConnection::send_climate_state(climate::Climate *climate) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_climate_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *climate = static_cast<climate::Climate *>(entity);
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
   resp.key = climate->get_object_id_hash();
@@ -583,7 +734,10 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.current_humidity = climate->current_humidity;
   if (traits.get_supports_target_humidity())
     resp.target_humidity = climate->target_humidity;
-  return this->send_climate_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_climate_state(climate::Climate *climate) {
+  return this->send_state_(climate, &encode_climate_state, ClimateStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -659,15 +813,16 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 #endif
 
 #ifdef USE_NUMBER
-bool APIConnection::send_number_state(number::Number *number, float state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_number_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *number = static_cast<number::Number *>(entity);
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
-  resp.state = state;
+  resp.state = number->state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_number_state(number::Number *number) {
+  return this->send_state_(number, &encode_number_state, NumberStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
@@ -701,17 +856,18 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 #endif
 
 #ifdef USE_DATETIME_DATE
-bool APIConnection::send_date_state(datetime::DateEntity *date) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_date_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *date = static_cast<datetime::DateEntity *>(entity);
   DateStateResponse resp{};
   resp.key = date->get_object_id_hash();
   resp.missing_state = !date->has_state();
   resp.year = date->year;
   resp.month = date->month;
   resp.day = date->day;
-  return this->send_date_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_date_state(datetime::DateEntity *date) {
+  return this->send_state_(date, &encode_date_state, DateStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_date_info(datetime::DateEntity *date) {
   ListEntitiesDateResponse msg;
@@ -738,17 +894,18 @@ void APIConnection::date_command(const DateCommandRequest &msg) {
 #endif
 
 #ifdef USE_DATETIME_TIME
-bool APIConnection::send_time_state(datetime::TimeEntity *time) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_time_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *time = static_cast<datetime::TimeEntity *>(entity);
   TimeStateResponse resp{};
   resp.key = time->get_object_id_hash();
   resp.missing_state = !time->has_state();
   resp.hour = time->hour;
   resp.minute = time->minute;
   resp.second = time->second;
-  return this->send_time_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_time_state(datetime::TimeEntity *time) {
+  return this->send_state_(time, &encode_time_state, TimeStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_time_info(datetime::TimeEntity *time) {
   ListEntitiesTimeResponse msg;
@@ -775,10 +932,8 @@ void APIConnection::time_command(const TimeCommandRequest &msg) {
 #endif
 
 #ifdef USE_DATETIME_DATETIME
-bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_datetime_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *datetime = static_cast<datetime::DateTimeEntity *>(entity);
   DateTimeStateResponse resp{};
   resp.key = datetime->get_object_id_hash();
   resp.missing_state = !datetime->has_state();
@@ -786,7 +941,10 @@ bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
     ESPTime state = datetime->state_as_esptime();
     resp.epoch_seconds = state.timestamp;
   }
-  return this->send_date_time_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
+  return this->send_state_(datetime, &encode_datetime_state, DateTimeStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_datetime_info(datetime::DateTimeEntity *datetime) {
   ListEntitiesDateTimeResponse msg;
@@ -813,15 +971,16 @@ void APIConnection::datetime_command(const DateTimeCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT
-bool APIConnection::send_text_state(text::Text *text, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_text_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *text = static_cast<text::Text *>(entity);
   TextStateResponse resp{};
   resp.key = text->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = text->state;
   resp.missing_state = !text->has_state();
-  return this->send_text_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_text_state(text::Text *text) {
+  return this->send_state_(text, &encode_text_state, TextStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_text_info(text::Text *text) {
   ListEntitiesTextResponse msg;
@@ -851,15 +1010,16 @@ void APIConnection::text_command(const TextCommandRequest &msg) {
 #endif
 
 #ifdef USE_SELECT
-bool APIConnection::send_select_state(select::Select *select, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_select_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *select = static_cast<select::Select *>(entity);
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = select->state;
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_select_state(select::Select *select) {
+  return this->send_state_(select, &encode_select_state, SelectStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
@@ -912,14 +1072,15 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 #endif
 
 #ifdef USE_LOCK
-bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_lock_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *a_lock = static_cast<lock::Lock *>(entity);
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
-  resp.state = static_cast<enums::LockState>(state);
-  return this->send_lock_state_response(resp);
+  resp.state = static_cast<enums::LockState>(a_lock->state);
+  resp.encode(buffer);
+}
+bool APIConnection::send_lock_state(lock::Lock *a_lock) {
+  return this->send_state_(a_lock, &encode_lock_state, LockStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
@@ -956,15 +1117,16 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
 #endif
 
 #ifdef USE_VALVE
-bool APIConnection::send_valve_state(valve::Valve *valve) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_valve_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *valve = static_cast<valve::Valve *>(entity);
   ValveStateResponse resp{};
   resp.key = valve->get_object_id_hash();
   resp.position = valve->position;
   resp.current_operation = static_cast<enums::ValveOperation>(valve->current_operation);
-  return this->send_valve_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_valve_state(valve::Valve *valve) {
+  return this->send_state_(valve, &encode_valve_state, ValveStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_valve_info(valve::Valve *valve) {
   auto traits = valve->get_traits();
@@ -998,10 +1160,8 @@ void APIConnection::valve_command(const ValveCommandRequest &msg) {
 #endif
 
 #ifdef USE_MEDIA_PLAYER
-bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_media_player_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *media_player = static_cast<media_player::MediaPlayer *>(entity);
   MediaPlayerStateResponse resp{};
   resp.key = media_player->get_object_id_hash();
 
@@ -1011,7 +1171,10 @@ bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_pla
   resp.state = static_cast<enums::MediaPlayerState>(report_state);
   resp.volume = media_player->volume;
   resp.muted = media_player->is_muted();
-  return this->send_media_player_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
+  return this->send_state_(media_player, &encode_media_player_state, MediaPlayerStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
@@ -1264,14 +1427,15 @@ void APIConnection::voice_assistant_set_configuration(const VoiceAssistantSetCon
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
-bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_alarm_control_panel_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *a_alarm_control_panel = static_cast<alarm_control_panel::AlarmControlPanel *>(entity);
   AlarmControlPanelStateResponse resp{};
   resp.key = a_alarm_control_panel->get_object_id_hash();
   resp.state = static_cast<enums::AlarmControlPanelState>(a_alarm_control_panel->get_state());
-  return this->send_alarm_control_panel_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+  return this->send_state_(a_alarm_control_panel, &encode_alarm_control_panel_state, AlarmControlPanelStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   ListEntitiesAlarmControlPanelResponse msg;
@@ -1346,10 +1510,8 @@ bool APIConnection::send_event_info(event::Event *event) {
 #endif
 
 #ifdef USE_UPDATE
-bool APIConnection::send_update_state(update::UpdateEntity *update) {
-  if (!this->state_subscription_)
-    return false;
-
+static void encode_update_state(EntityBase *entity, ProtoWriteBuffer buffer) {
+  auto *update = static_cast<update::UpdateEntity *>(entity);
   UpdateStateResponse resp{};
   resp.key = update->get_object_id_hash();
   resp.missing_state = !update->has_state();
@@ -1365,8 +1527,10 @@ bool APIConnection::send_update_state(update::UpdateEntity *update) {
     resp.release_summary = update->update_info.summary;
     resp.release_url = update->update_info.release_url;
   }
-
-  return this->send_update_state_response(resp);
+  resp.encode(buffer);
+}
+bool APIConnection::send_update_state(update::UpdateEntity *update) {
+  return this->send_state_(update, &encode_update_state, UpdateStateResponse::MESSAGE_TYPE);
 }
 bool APIConnection::send_update_info(update::UpdateEntity *update) {
   ListEntitiesUpdateResponse msg;
@@ -1404,15 +1568,19 @@ void APIConnection::update_command(const UpdateCommandRequest &msg) {
 #endif
 
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
-  if (this->log_subscription_ < level)
+  return this->send_log_message(level, reinterpret_cast<const uint8_t *>(line), strlen(line));
+}
+bool APIConnection::send_log_message(int level, const uint8_t *message, size_t len) {
+  if (!this->is_log_subscribed(level))
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  // level (2 bytes), message (up to 4 bytes of key and length)
+  auto buffer = this->create_buffer(len + 6);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
-  // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  // bytes message = 3;
+  buffer.encode_bytes(3, message, len);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -1429,7 +1597,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
 
   HelloResponse resp;
   resp.api_version_major = 1;
-  resp.api_version_minor = 10;
+  resp.api_version_minor = 11;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   resp.name = App.get_name();
 
@@ -1463,6 +1631,7 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
   resp.mac_address = get_mac_address_pretty();
   resp.esphome_version = ESPHOME_VERSION;
   resp.compilation_time = App.get_compilation_time();
+  resp.config_hash = this->parent_->get_config_hash();
 #if defined(USE_ESP8266) || defined(USE_ESP32)
   resp.manufacturer = "Espressif";
 #elif defined(USE_RP2040)
@@ -1538,7 +1707,20 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  std::vector<uint8_t> &data = *buffer.get_buffer();
+  size_t payload_len = data.size() - this->helper_->frame_header_padding();
+  data.resize(data.size() + this->helper_->frame_footer_size());
+  APIError err = this->helper_->write_packet(message_type, data.data(), payload_len);
+  // Do not set last_traffic_ on send
+  bool sent = this->handle_write_result_(err);
+#ifdef USE_TICKLESS_LOOP
+  // What the socket didn't take is sent by loop(), which may have reported idle already
+  if (!this->helper_->can_write_without_blocking())
+    App.wake_loop_any_context();
+#endif
+  return sent;
+}
+bool APIConnection::handle_write_result_(APIError err) {
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -1551,9 +1733,23 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
-  // Do not set last_traffic_ on send
   return true;
 }
+void APIConnection::log_traffic_stats_() {
+  const APIFrameStats &stats = this->helper_->get_stats();
+  ESP_LOGD(TAG, "%s: Sent %" PRIu32 " messages (%" PRIu32 " kB), received %" PRIu32 " messages (%" PRIu32 " kB)",
+           this->client_combined_info_.c_str(), stats.tx_frames, static_cast<uint32_t>(stats.tx_bytes / 1024),
+           stats.rx_frames, static_cast<uint32_t>(stats.rx_bytes / 1024));
+  // bytes per ms is roughly kB/s
+  if (stats.encrypt_us != 0) {
+    ESP_LOGD(TAG, "%s: Encryption at %" PRIu32 " kB/s (%" PRIu32 " ms total)", this->client_combined_info_.c_str(),
+             static_cast<uint32_t>(stats.tx_bytes * 1000 / stats.encrypt_us), stats.encrypt_us / 1000);
+  }
+  if (stats.decrypt_us != 0) {
+    ESP_LOGD(TAG, "%s: Decryption at %" PRIu32 " kB/s (%" PRIu32 " ms total)", this->client_combined_info_.c_str(),
+             static_cast<uint32_t>(stats.rx_bytes * 1000 / stats.decrypt_us), stats.decrypt_us / 1000);
+  }
+}
 void APIConnection::on_unauthenticated_access() {
   this->on_fatal_error();
   ESP_LOGD(TAG, "%s: tried to access without authentication.", this->client_combined_info_.c_str());
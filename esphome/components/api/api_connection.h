@@ -26,8 +26,9 @@ class APIConnection : public APIServerConnection {
     ListEntitiesDoneResponse resp;
     return this->send_list_entities_done_response(resp);
   }
+  bool send_initial_states_done();
 #ifdef USE_BINARY_SENSOR
-  bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
 #endif
 #ifdef USE_COVER
@@ -46,16 +47,16 @@ class APIConnection : public APIServerConnection {
   void light_command(const LightCommandRequest &msg) override;
 #endif
 #ifdef USE_SENSOR
-  bool send_sensor_state(sensor::Sensor *sensor, float state);
+  bool send_sensor_state(sensor::Sensor *sensor);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
 #ifdef USE_SWITCH
-  bool send_switch_state(switch_::Switch *a_switch, bool state);
+  bool send_switch_state(switch_::Switch *a_switch);
   bool send_switch_info(switch_::Switch *a_switch);
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
-  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -69,7 +70,7 @@ class APIConnection : public APIServerConnection {
   void climate_command(const ClimateCommandRequest &msg) override;
 #endif
 #ifdef USE_NUMBER
-  bool send_number_state(number::Number *number, float state);
+  bool send_number_state(number::Number *number);
   bool send_number_info(number::Number *number);
   void number_command(const NumberCommandRequest &msg) override;
 #endif
@@ -89,12 +90,12 @@ class APIConnection : public APIServerConnection {
   void datetime_command(const DateTimeCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT
-  bool send_text_state(text::Text *text, std::string state);
+  bool send_text_state(text::Text *text);
   bool send_text_info(text::Text *text);
   void text_command(const TextCommandRequest &msg) override;
 #endif
 #ifdef USE_SELECT
-  bool send_select_state(select::Select *select, std::string state);
+  bool send_select_state(select::Select *select);
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
@@ -103,7 +104,7 @@ class APIConnection : public APIServerConnection {
   void button_command(const ButtonCommandRequest &msg) override;
 #endif
 #ifdef USE_LOCK
-  bool send_lock_state(lock::Lock *a_lock, lock::LockState state);
+  bool send_lock_state(lock::Lock *a_lock);
   bool send_lock_info(lock::Lock *a_lock);
   void lock_command(const LockCommandRequest &msg) override;
 #endif
@@ -118,6 +119,12 @@ class APIConnection : public APIServerConnection {
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+  /// Send a log message that is not null terminated, like a tokenized one.
+  bool send_log_message(int level, const uint8_t *message, size_t len);
+  /// Whether log messages of `level` are sent to this client.
+  bool is_log_subscribed(int level) const { return this->log_subscription_ >= level; }
+  /// Whether this client asked for tokenized log messages instead of their text.
+  bool is_log_tokenized() const { return this->log_tokenized_; }
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -191,12 +198,10 @@ class APIConnection : public APIServerConnection {
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+    this->log_tokenized_ = msg.tokenized;
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -217,9 +222,13 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    // Leave room for the frame header and the MAC, so that the frame helper doesn't need to copy the message
+    const uint8_t header_padding = this->helper_->frame_header_padding();
+    this->proto_write_buffer_.reserve(header_padding + reserve_size + this->helper_->frame_footer_size());
+    this->proto_write_buffer_.resize(header_padding);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -230,6 +239,14 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  /// Send a state message now, or queue it for the next batch if the API server has a batch delay and only the newest
+  /// state of the entity matters.
+  bool send_state_(EntityBase *entity, StateEncoder encoder, uint16_t message_type);
+  bool send_state_generation_();
+  /// Send queued state messages together, in as few socket writes as possible.
+  void send_state_batch_();
+  void log_traffic_stats_();
+  bool handle_write_result_(APIError err);
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -238,10 +255,24 @@ class APIConnection : public APIServerConnection {
   } connection_state_{ConnectionState::WAITING_FOR_HELLO};
 
   bool remove_{false};
+#ifdef USE_TICKLESS_LOOP
+  /// Whether the last loop() had nothing to read or send.
+  bool idle_{false};
+#endif
 
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
+
+  struct StateBatchItem {
+    EntityBase *entity;
+    StateEncoder encoder;
+    uint16_t message_type;
+  };
+  /// State messages waiting for the batch delay to pass, at most one per entity.
+  std::vector<StateBatchItem> state_batch_;
+  std::vector<PacketInfo> state_batch_packets_;
+  uint32_t state_batch_start_{0};
   std::unique_ptr<APIFrameHelper> helper_;
 
   std::string client_info_;
@@ -254,7 +285,16 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  /// The client asked for StateGenerationResponse messages.
+  bool state_generation_subscription_{false};
+  bool initial_states_sent_{false};
+  bool sending_initial_states_{false};
+  /// A state change couldn't be sent, so no later generation may be reported to the client.
+  bool state_dropped_{false};
+  uint32_t state_generation_sent_{0};
+  uint32_t state_generation_sent_at_{0};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+  bool log_tokenized_{false};
   uint32_t last_traffic_;
   uint32_t next_ping_retry_{0};
   uint8_t ping_retries_{0};
@@ -5,6 +5,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 #include "proto.h"
+#include <cinttypes>
 #include <cstring>
 
 namespace esphome {
@@ -224,8 +225,8 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
     return APIError::BAD_HANDSHAKE_PACKET_LEN;
   }
 
-  // reserve space for body
-  if (rx_buf_.size() != msg_size) {
+  // the buffer is kept between frames, only grow it
+  if (rx_buf_.size() < msg_size) {
     rx_buf_.resize(msg_size);
   }
 
@@ -254,11 +255,11 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
 
   // uncomment for even more debugging
 #ifdef HELPER_LOG_PACKETS
-  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
+  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_.data(), msg_size).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
+  frame->msg = rx_buf_.data();
+  frame->msg_len = msg_size;
   // consume msg
-  rx_buf_ = {};
   rx_buf_len_ = 0;
   rx_header_buf_len_ = 0;
   return APIError::OK;
@@ -295,9 +296,9 @@ APIError APINoiseFrameHelper::state_action_() {
     if (aerr != APIError::OK)
       return aerr;
     // ignore contents, may be used in future for flags
-    prologue_.push_back((uint8_t) (frame.msg.size() >> 8));
-    prologue_.push_back((uint8_t) frame.msg.size());
-    prologue_.insert(prologue_.end(), frame.msg.begin(), frame.msg.end());
+    prologue_.push_back((uint8_t) (frame.msg_len >> 8));
+    prologue_.push_back((uint8_t) frame.msg_len);
+    prologue_.insert(prologue_.end(), frame.msg, frame.msg + frame.msg_len);
 
     state_ = State::SERVER_HELLO;
   }
@@ -340,7 +341,7 @@ APIError APINoiseFrameHelper::state_action_() {
       if (aerr != APIError::OK)
         return aerr;
 
-      if (frame.msg.empty()) {
+      if (frame.msg_len == 0) {
         send_explicit_handshake_reject_("Empty handshake message");
         return APIError::BAD_HANDSHAKE_ERROR_BYTE;
       } else if (frame.msg[0] != 0x00) {
@@ -351,7 +352,7 @@ APIError APINoiseFrameHelper::state_action_() {
 
       NoiseBuffer mbuf;
       noise_buffer_init(mbuf);
-      noise_buffer_set_input(mbuf, frame.msg.data() + 1, frame.msg.size() - 1);
+      noise_buffer_set_input(mbuf, frame.msg + 1, frame.msg_len - 1);
       err = noise_handshakestate_read_message(handshake_, &mbuf, nullptr);
       if (err != 0) {
         state_ = State::FAILED;
@@ -430,10 +431,13 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   if (aerr != APIError::OK)
     return aerr;
 
+  // decrypt in place, the message stays in rx_buf_
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, frame.msg.data(), frame.msg.size(), frame.msg.size());
+  noise_buffer_set_inout(mbuf, frame.msg, frame.msg_len, frame.msg_len);
+  uint32_t start = micros();
   err = noise_cipherstate_decrypt(recv_cipher_, &mbuf);
+  this->stats_.decrypt_us += micros() - start;
   if (err != 0) {
     state_ = State::FAILED;
     HELPER_LOG("noise_cipherstate_decrypt failed: %s", noise_err_to_str(err).c_str());
@@ -441,7 +445,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   size_t msg_size = mbuf.size;
-  uint8_t *msg_data = frame.msg.data();
+  uint8_t *msg_data = frame.msg;
   if (msg_size < 4) {
     state_ = State::FAILED;
     HELPER_LOG("Bad data packet: size %d too short", msg_size);
@@ -460,15 +464,15 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
     return APIError::BAD_DATA_PACKET;
   }
 
-  buffer->container = std::move(frame.msg);
-  buffer->data_offset = 4;
+  this->stats_.rx_frames++;
+  this->stats_.rx_bytes += data_len;
+  buffer->data = msg_data + 4;
   buffer->data_len = data_len;
   buffer->type = type;
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
-  int err;
+APIError APINoiseFrameHelper::write_packet(uint16_t type, uint8_t *buffer, size_t payload_len) {
   APIError aerr;
   aerr = state_action_();
   if (aerr != APIError::OK) {
@@ -479,48 +483,86 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  struct iovec iov;
+  aerr = encrypt_packet_(buffer, PacketInfo{type, frame_header_padding_, static_cast<uint32_t>(payload_len)}, &iov);
+  if (aerr != APIError::OK)
+    return aerr;
+  // write raw to not have two packets sent if NAGLE disabled
+  return write_raw_(&iov, 1);
+}
+APIError APINoiseFrameHelper::write_packets(uint8_t *buffer, const std::vector<PacketInfo> &packets) {
+  APIError aerr;
+  aerr = state_action_();
+  if (aerr != APIError::OK) {
+    return aerr;
+  }
+
+  if (state_ != State::DATA) {
+    return APIError::WOULD_BLOCK;
+  }
+  if (packets.empty()) {
+    return APIError::OK;
+  }
+
+  // Every message still gets its own encrypted frame, but all frames are written to the socket at once
+  tx_iov_.clear();
+  for (const auto &packet : packets) {
+    struct iovec iov;
+    aerr = encrypt_packet_(buffer, packet, &iov);
+    if (aerr != APIError::OK)
+      return aerr;
+    // frames of messages packed without gaps are one block
+    if (!tx_iov_.empty() &&
+        reinterpret_cast<uint8_t *>(tx_iov_.back().iov_base) + tx_iov_.back().iov_len == iov.iov_base) {
+      tx_iov_.back().iov_len += iov.iov_len;
+    } else {
+      tx_iov_.push_back(iov);
+    }
+  }
+  return write_raw_(tx_iov_.data(), tx_iov_.size());
+}
+/** Turn a message in `buffer` into an encrypted frame in place.
+ *
+ * @param buffer The buffer holding the message, with frame_header_padding_ bytes in front of the payload and
+ *   frame_footer_size_ bytes after it.
+ * @param packet Where in `buffer` the message is.
+ * @param iov Set to the complete frame.
+ */
+APIError APINoiseFrameHelper::encrypt_packet_(uint8_t *buffer, const PacketInfo &packet, struct iovec *iov) {
   size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
-
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
-  const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  size_t msg_len = 4 + packet.payload_size + padding;
+  if (packet.offset < frame_header_padding_ || 3 + msg_len + NOISE_MAC_LEN > 0xFFFF) {
+    HELPER_LOG("Bad packet for encryption: offset %u, size %" PRIu32, packet.offset, packet.payload_size);
+    return APIError::BAD_ARG;
+  }
+
+  uint8_t *frame = buffer + packet.offset - frame_header_padding_;
+  frame[0] = 0x01;  // indicator
+  // frame[1], frame[2] to be set after encryption
+  frame[3] = (uint8_t) (packet.message_type >> 8);  // type
+  frame[4] = (uint8_t) packet.message_type;
+  frame[5] = (uint8_t) (packet.payload_size >> 8);  // data_len
+  frame[6] = (uint8_t) packet.payload_size;
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
-  err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
+  noise_buffer_set_inout(mbuf, &frame[3], msg_len, msg_len + NOISE_MAC_LEN);
+  uint32_t start = micros();
+  int err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
+  this->stats_.encrypt_us += micros() - start;
   if (err != 0) {
     state_ = State::FAILED;
     HELPER_LOG("noise_cipherstate_encrypt failed: %s", noise_err_to_str(err).c_str());
     return APIError::CIPHERSTATE_ENCRYPT_FAILED;
   }
+  frame[1] = (uint8_t) (mbuf.size >> 8);
+  frame[2] = (uint8_t) mbuf.size;
 
-  size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
-
-  struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
-  iov.iov_len = total_len;
-
-  // write raw to not have two packets sent if NAGLE disabled
-  return write_raw_(&iov, 1);
+  this->stats_.tx_frames++;
+  this->stats_.tx_bytes += packet.payload_size;
+  iov->iov_base = frame;
+  iov->iov_len = 3 + mbuf.size;
+  return APIError::OK;
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -843,8 +885,8 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
   }
   // header reading done
 
-  // reserve space for body
-  if (rx_buf_.size() != rx_header_parsed_len_) {
+  // the buffer is kept between frames, only grow it
+  if (rx_buf_.size() < rx_header_parsed_len_) {
     rx_buf_.resize(rx_header_parsed_len_);
   }
 
@@ -873,11 +915,11 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
 
   // uncomment for even more debugging
 #ifdef HELPER_LOG_PACKETS
-  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
+  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_.data(), rx_header_parsed_len_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
+  frame->msg = rx_buf_.data();
+  frame->msg_len = rx_header_parsed_len_;
   // consume msg
-  rx_buf_ = {};
   rx_buf_len_ = 0;
   rx_header_buf_.clear();
   rx_header_parsed_ = false;
@@ -896,33 +938,70 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   if (aerr != APIError::OK)
     return aerr;
 
-  buffer->container = std::move(frame.msg);
-  buffer->data_offset = 0;
-  buffer->data_len = rx_header_parsed_len_;
+  this->stats_.rx_frames++;
+  this->stats_.rx_bytes += frame.msg_len;
+  buffer->data = frame.msg;
+  buffer->data_len = frame.msg_len;
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APIPlaintextFrameHelper::write_packet(uint16_t type, uint8_t *buffer, size_t payload_len) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  struct iovec iov;
+  APIError aerr =
+      write_header_(buffer, PacketInfo{type, frame_header_padding_, static_cast<uint32_t>(payload_len)}, &iov);
+  if (aerr != APIError::OK)
+    return aerr;
+  return write_raw_(&iov, 1);
+}
+APIError APIPlaintextFrameHelper::write_packets(uint8_t *buffer, const std::vector<PacketInfo> &packets) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+  if (packets.empty()) {
+    return APIError::OK;
+  }
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
+  // The headers are shorter than the padding for most messages, so every frame is a block of its own
+  tx_iov_.clear();
+  for (const auto &packet : packets) {
+    struct iovec iov;
+    APIError aerr = write_header_(buffer, packet, &iov);
+    if (aerr != APIError::OK)
+      return aerr;
+    tx_iov_.push_back(iov);
+  }
+  return write_raw_(tx_iov_.data(), tx_iov_.size());
+}
+/** Write the frame header of a message in `buffer` right in front of its payload.
+ *
+ * @param buffer The buffer holding the message, with frame_header_padding_ bytes in front of the payload.
+ * @param packet Where in `buffer` the message is.
+ * @param iov Set to the complete frame.
+ */
+APIError APIPlaintextFrameHelper::write_header_(uint8_t *buffer, const PacketInfo &packet, struct iovec *iov) {
+  uint32_t header_len =
+      1 + ProtoSize::varint(packet.payload_size) + ProtoSize::varint(static_cast<uint32_t>(packet.message_type));
+  if (header_len > frame_header_padding_ || packet.offset < header_len) {
+    HELPER_LOG("Bad packet for header: offset %u, size %" PRIu32, packet.offset, packet.payload_size);
+    return APIError::BAD_ARG;
   }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
 
-  return write_raw_(iov, 2);
+  uint8_t *frame = buffer + packet.offset - header_len;
+  uint8_t *pos = frame;
+  *pos++ = 0x00;  // indicator
+  pos += ProtoVarInt(packet.payload_size).encode_to(pos);
+  ProtoVarInt(packet.message_type).encode_to(pos);
+
+  this->stats_.tx_frames++;
+  this->stats_.tx_bytes += packet.payload_size;
+  iov->iov_base = frame;
+  iov->iov_len = header_len + packet.payload_size;
+  return APIError::OK;
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
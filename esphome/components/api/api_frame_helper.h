@@ -17,9 +17,9 @@ namespace esphome {
 namespace api {
 
 struct ReadPacketBuffer {
-  std::vector<uint8_t> container;
+  /// Points into the receive buffer of the frame helper, only valid until the next read_packet() call.
+  uint8_t *data;
   uint16_t type;
-  size_t data_offset;
   size_t data_len;
 };
 
@@ -30,6 +30,13 @@ struct PacketBuffer {
   uint8_t data_len;
 };
 
+/// A message inside a buffer holding multiple encoded messages, see APIFrameHelper::write_packets().
+struct PacketInfo {
+  uint16_t message_type;
+  uint16_t offset;
+  uint32_t payload_size;
+};
+
 enum class APIError : int {
   OK = 0,
   WOULD_BLOCK = 1001,
@@ -58,6 +65,16 @@ enum class APIError : int {
 
 const char *api_error_to_str(APIError err);
 
+/// Traffic counters of a single connection.
+struct APIFrameStats {
+  uint32_t rx_frames{0};
+  uint32_t tx_frames{0};
+  uint64_t rx_bytes{0};  ///< Message bytes, without frame headers and MACs
+  uint64_t tx_bytes{0};
+  uint32_t decrypt_us{0};  ///< Time spent decrypting received frames, stays 0 without encryption
+  uint32_t encrypt_us{0};  ///< Time spent encrypting sent frames, stays 0 without encryption
+};
+
 class APIFrameHelper {
  public:
   virtual ~APIFrameHelper() = default;
@@ -65,26 +82,50 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Frame and send a message in place.
+   *
+   * The payload starts frame_header_padding() bytes into `buffer`, and frame_footer_size() bytes after the payload
+   * must be writable too. The helper writes the frame header in front of the payload and encrypts it in place, so no
+   * copy of the message is made unless the socket can't take all of it.
+   */
+  virtual APIError write_packet(uint16_t type, uint8_t *buffer, size_t payload_len) = 0;
+  /// Like write_packet() for multiple messages in `buffer`, each with its own header padding and footer, which are
+  /// handed to the socket with a single write.
+  virtual APIError write_packets(uint8_t *buffer, const std::vector<PacketInfo> &packets) = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+  /// Number of bytes to leave in front of every message payload for the frame header.
+  uint8_t frame_header_padding() const { return this->frame_header_padding_; }
+  /// Number of bytes to leave after every message payload, for the MAC of encrypted frames.
+  uint8_t frame_footer_size() const { return this->frame_footer_size_; }
+  const APIFrameStats &get_stats() const { return this->stats_; }
+
+ protected:
+  uint8_t frame_header_padding_{0};
+  uint8_t frame_footer_size_{0};
+  APIFrameStats stats_{};
 };
 
 #ifdef USE_API_NOISE
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
-      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {}
+      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {
+    // indicator, frame size, message type, data length
+    this->frame_header_padding_ = 7;
+    this->frame_footer_size_ = NOISE_MAC_LEN;
+  }
   ~APINoiseFrameHelper() override;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_packet(uint16_t type, uint8_t *buffer, size_t payload_len) override;
+  APIError write_packets(uint8_t *buffer, const std::vector<PacketInfo> &packets) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -95,14 +136,19 @@ class APINoiseFrameHelper : public APIFrameHelper {
   void set_log_info(std::string info) override { info_ = std::move(info); }
 
  protected:
+  /// MAC length of ChaChaPoly, the only cipher this helper uses.
+  static constexpr uint8_t NOISE_MAC_LEN = 16;
+
   struct ParsedFrame {
-    std::vector<uint8_t> msg;
+    uint8_t *msg;  ///< Points into rx_buf_, valid until the next try_read_frame_() call
+    size_t msg_len;
   };
 
   APIError state_action_();
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_frame_(const uint8_t *data, size_t len);
+  APIError encrypt_packet_(uint8_t *buffer, const PacketInfo &packet, struct iovec *iov);
   APIError write_raw_(const struct iovec *iov, int iovcnt);
   APIError init_handshake_();
   APIError check_handshake_finished_();
@@ -113,10 +159,13 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::string info_;
   uint8_t rx_header_buf_[3];
   size_t rx_header_buf_len_ = 0;
+  /// Receive buffer, reused for every frame so it only grows to the largest frame received.
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  /// Reused for the frames of write_packets().
+  std::vector<struct iovec> tx_iov_;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -141,13 +190,17 @@ class APINoiseFrameHelper : public APIFrameHelper {
 #ifdef USE_API_PLAINTEXT
 class APIPlaintextFrameHelper : public APIFrameHelper {
  public:
-  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {}
+  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {
+    // indicator, varint of the payload size (up to 3 bytes), varint of the message type (up to 2 bytes)
+    this->frame_header_padding_ = 6;
+  }
   ~APIPlaintextFrameHelper() override = default;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_packet(uint16_t type, uint8_t *buffer, size_t payload_len) override;
+  APIError write_packets(uint8_t *buffer, const std::vector<PacketInfo> &packets) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -159,11 +212,13 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
 
  protected:
   struct ParsedFrame {
-    std::vector<uint8_t> msg;
+    uint8_t *msg;  ///< Points into rx_buf_, valid until the next try_read_frame_() call
+    size_t msg_len;
   };
 
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
+  APIError write_header_(uint8_t *buffer, const PacketInfo &packet, struct iovec *iov);
   APIError write_raw_(const struct iovec *iov, int iovcnt);
 
   std::unique_ptr<socket::Socket> socket_;
@@ -174,10 +229,13 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   uint32_t rx_header_parsed_type_ = 0;
   uint32_t rx_header_parsed_len_ = 0;
 
+  /// Receive buffer, reused for every frame so it only grows to the largest frame received.
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  /// Reused for the frames of write_packets().
+  std::vector<struct iovec> tx_iov_;
 
   enum class State {
     INITIALIZE = 1,
@@ -25,6 +25,8 @@ static const char *const TAG = "api";
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
+  // Never 0, which clients send when they don't know the epoch
+  this->state_epoch_ = random_uint32() | 1;
   socket_ = socket::socket_ip(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
@@ -66,15 +68,41 @@ void APIServer::setup() {
     this->mark_failed();
     return;
   }
+#ifdef USE_TICKLESS_LOOP
+  socket::set_wake_loop_on_readable(this->socket_.get(), true);
+#endif
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
+#ifdef USE_LOGGER_TOKENIZED
+    // Only clients that asked for it get tokenized messages, which they decode with the token dictionary of the
+    // build like `esphome logs` does. All other clients get the text.
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message, bool tokenized) {
+          for (auto &c : this->clients_) {
+            if (!c->remove_ && !(tokenized && c->is_log_tokenized()))
+              c->send_log_message(level, tag, message);
+          }
+        },
+        [this](int level, const uint8_t *message, size_t len, bool *text_needed) {
+          for (auto &c : this->clients_) {
+            if (c->remove_)
+              continue;
+            if (c->is_log_tokenized()) {
+              c->send_log_message(level, message, len);
+            } else if (c->is_log_subscribed(level)) {
+              *text_needed = true;
+            }
+          }
+        });
+#else
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
       for (auto &c : this->clients_) {
         if (!c->remove_)
           c->send_log_message(level, tag, message);
       }
     });
+#endif
   }
 #endif
 
@@ -101,6 +129,9 @@ void APIServer::loop() {
     if (!sock)
       break;
     ESP_LOGD(TAG, "Accepted %s", sock->getpeername().c_str());
+#ifdef USE_TICKLESS_LOOP
+    socket::set_wake_loop_on_readable(sock.get(), true);
+#endif
 
     auto *conn = new APIConnection(std::move(sock), this);
     clients_.emplace_back(conn);
@@ -114,13 +145,21 @@ void APIServer::loop() {
   for (auto it = new_end; it != this->clients_.end(); ++it) {
     this->client_disconnected_trigger_->trigger((*it)->client_info_, (*it)->client_peername_);
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
+    (*it)->log_traffic_stats_();
   }
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
 
+  bool idle = true;
   for (auto &client : this->clients_) {
     client->loop();
+#ifdef USE_TICKLESS_LOOP
+    idle &= client->idle_;
+#endif
   }
+  // New connections and packets wake the loop through the sockets
+  if (idle)
+    this->report_loop_idle();
 
   if (this->reboot_timeout_ != 0) {
     const uint32_t now = millis();
@@ -175,12 +214,31 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
+void APIServer::on_state_changed_(EntityBase *obj) {
+  if (++this->state_generation_ == 0) {
+    // Wrapped around, start a new epoch so that clients can't mistake old generations for new ones
+    this->state_epoch_ = random_uint32() | 1;
+    this->state_generation_ = 1;
+    this->state_cache_.clear();
+  }
+  obj->set_state_generation(this->state_generation_);
+}
+void APIServer::encode_state(EntityBase *entity, StateEncoder encoder, uint16_t message_type,
+                             ProtoWriteBuffer buffer) {
+  // Only worth the copy when the message is sent more than once
+  if (this->clients_.size() < 2) {
+    encoder(entity, buffer);
+    return;
+  }
+  this->state_cache_.append(entity, encoder, message_type, *buffer.get_buffer());
+}
 #ifdef USE_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_binary_sensor_state(obj, state);
+    c->send_binary_sensor_state(obj);
 }
 #endif
 
@@ -188,6 +246,7 @@ void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
 void APIServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_cover_state(obj);
 }
@@ -197,6 +256,7 @@ void APIServer::on_cover_update(cover::Cover *obj) {
 void APIServer::on_fan_update(fan::Fan *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_fan_state(obj);
 }
@@ -206,6 +266,7 @@ void APIServer::on_fan_update(fan::Fan *obj) {
 void APIServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_light_state(obj);
 }
@@ -215,8 +276,9 @@ void APIServer::on_light_update(light::LightState *obj) {
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_sensor_state(obj, state);
+    c->send_sensor_state(obj);
 }
 #endif
 
@@ -224,8 +286,9 @@ void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_switch_state(obj, state);
+    c->send_switch_state(obj);
 }
 #endif
 
@@ -233,8 +296,9 @@ void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
 void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_text_sensor_state(obj, state);
+    c->send_text_sensor_state(obj);
 }
 #endif
 
@@ -242,6 +306,7 @@ void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
 void APIServer::on_climate_update(climate::Climate *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_climate_state(obj);
 }
@@ -251,8 +316,9 @@ void APIServer::on_climate_update(climate::Climate *obj) {
 void APIServer::on_number_update(number::Number *obj, float state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_number_state(obj, state);
+    c->send_number_state(obj);
 }
 #endif
 
@@ -260,6 +326,7 @@ void APIServer::on_number_update(number::Number *obj, float state) {
 void APIServer::on_date_update(datetime::DateEntity *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_date_state(obj);
 }
@@ -269,6 +336,7 @@ void APIServer::on_date_update(datetime::DateEntity *obj) {
 void APIServer::on_time_update(datetime::TimeEntity *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_time_state(obj);
 }
@@ -278,6 +346,7 @@ void APIServer::on_time_update(datetime::TimeEntity *obj) {
 void APIServer::on_datetime_update(datetime::DateTimeEntity *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_datetime_state(obj);
 }
@@ -287,8 +356,9 @@ void APIServer::on_datetime_update(datetime::DateTimeEntity *obj) {
 void APIServer::on_text_update(text::Text *obj, const std::string &state) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_text_state(obj, state);
+    c->send_text_state(obj);
 }
 #endif
 
@@ -296,8 +366,9 @@ void APIServer::on_text_update(text::Text *obj, const std::string &state) {
 void APIServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_select_state(obj, state);
+    c->send_select_state(obj);
 }
 #endif
 
@@ -305,8 +376,9 @@ void APIServer::on_select_update(select::Select *obj, const std::string &state,
 void APIServer::on_lock_update(lock::Lock *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
-    c->send_lock_state(obj, obj->state);
+    c->send_lock_state(obj);
 }
 #endif
 
@@ -314,6 +386,7 @@ void APIServer::on_lock_update(lock::Lock *obj) {
 void APIServer::on_valve_update(valve::Valve *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_valve_state(obj);
 }
@@ -323,6 +396,7 @@ void APIServer::on_valve_update(valve::Valve *obj) {
 void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_media_player_state(obj);
 }
@@ -337,6 +411,7 @@ void APIServer::on_event(event::Event *obj, const std::string &event_type) {
 
 #ifdef USE_UPDATE
 void APIServer::on_update(update::UpdateEntity *obj) {
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_update_state(obj);
 }
@@ -397,6 +472,7 @@ void APIServer::on_shutdown() {
 void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
   if (obj->is_internal())
     return;
+  this->on_state_changed_(obj);
   for (auto &c : this->clients_)
     c->send_alarm_control_panel_state(obj);
 }
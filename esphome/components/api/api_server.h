@@ -5,6 +5,7 @@
 #include "api_noise_context.h"
 #include "api_pb2.h"
 #include "api_pb2_service.h"
+#include "encoded_state_cache.h"
 #include "esphome/components/socket/socket.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
@@ -33,6 +34,18 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Collect state changes for this many ms and send them together, 0 sends every state change right away.
+  void set_batch_delay(uint16_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint16_t get_batch_delay() const { return this->batch_delay_; }
+  /// Hash of the configuration, clients use it to cache the entity list and the states.
+  void set_config_hash(uint32_t config_hash) { this->config_hash_ = config_hash; }
+  uint32_t get_config_hash() const { return this->config_hash_; }
+  /// Random value picked at boot, state generations are only comparable within the same epoch.
+  uint32_t get_state_epoch() const { return this->state_epoch_; }
+  /// Incremented on every state change of a non-internal entity.
+  uint32_t get_state_generation() const { return this->state_generation_; }
+  /// Append the state message of `entity` to `buffer`, sharing the encoded message between connections.
+  void encode_state(EntityBase *entity, StateEncoder encoder, uint16_t message_type, ProtoWriteBuffer buffer);
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -129,9 +142,16 @@ class APIServer : public Component, public Controller {
   }
 
  protected:
+  void on_state_changed_(EntityBase *obj);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint16_t batch_delay_{0};
+  uint32_t config_hash_{0};
+  uint32_t state_epoch_{0};
+  uint32_t state_generation_{0};
+  EncodedStateCache state_cache_;
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
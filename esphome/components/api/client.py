@@ -9,6 +9,7 @@ from aioesphomeapi import APIClient
 from aioesphomeapi.api_pb2 import SubscribeLogsResponse
 from aioesphomeapi.log_runner import async_run
 
+from esphome.components.logger import tokenizer
 from esphome.const import CONF_KEY, CONF_PASSWORD, CONF_PORT, __version__
 from esphome.core import CORE
 
@@ -35,12 +36,15 @@ async def async_run_logs(config: dict[str, Any], address: str) -> None:
         noise_psk=noise_psk,
     )
     dashboard = CORE.dashboard
+    tokens = tokenizer.load_build_dictionary(config)
 
     def on_log(msg: SubscribeLogsResponse) -> None:
         """Handle a new log message."""
         time_ = datetime.now()
         message: bytes = msg.message
-        text = message.decode("utf8", "backslashreplace")
+        text = tokenizer.decode(message, tokens)
+        if text is None:
+            text = message.decode("utf8", "backslashreplace")
         if dashboard:
             text = text.replace("\033", "\\033")
         print(f"[{time_.hour:02}:{time_.minute:02}:{time_.second:02}]{text}")
@@ -0,0 +1,35 @@
+#include "encoded_state_cache.h"
+#ifdef USE_API
+
+namespace esphome {
+namespace api {
+
+void EncodedStateCache::append(EntityBase *entity, StateEncoder encoder, uint16_t message_type,
+                               std::vector<uint8_t> &out) {
+  const uint32_t state_generation = entity->get_state_generation();
+  for (auto &entry : this->entries_) {
+    if (entry.entity == entity && entry.message_type == message_type && entry.state_generation == state_generation) {
+      out.insert(out.end(), entry.data.begin(), entry.data.end());
+      return;
+    }
+  }
+
+  // Replace the oldest entry, an entity that changes again gets a new one anyway
+  Entry &entry = this->entries_[this->next_];
+  this->next_ = (this->next_ + 1) % SIZE;
+  entry.entity = entity;
+  entry.message_type = message_type;
+  entry.state_generation = state_generation;
+  entry.data.clear();
+  encoder(entity, ProtoWriteBuffer(&entry.data));
+  out.insert(out.end(), entry.data.begin(), entry.data.end());
+}
+
+void EncodedStateCache::clear() {
+  for (auto &entry : this->entries_)
+    entry.entity = nullptr;
+}
+
+}  // namespace api
+}  // namespace esphome
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_API
+#include "esphome/core/entity_base.h"
+#include "proto.h"
+
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/// Encodes the current state of an entity, so that state messages can be built when they are actually sent.
+using StateEncoder = void (*)(EntityBase *entity, ProtoWriteBuffer buffer);
+
+/** Recently encoded state messages, shared by all API connections.
+ *
+ * With multiple clients subscribed, every state change is sent once per connection. An entry stays valid as long as
+ * the state generation of its entity doesn't change, so the message is only encoded for the first connection and
+ * copied for the others. Encryption and framing still happen per connection.
+ */
+class EncodedStateCache {
+ public:
+  /// Append the state message of `entity` to `out`, encoding it only if it isn't cached for the current state.
+  void append(EntityBase *entity, StateEncoder encoder, uint16_t message_type, std::vector<uint8_t> &out);
+  /// Forget all entries, for when state generations start over.
+  void clear();
+
+ protected:
+  /// Enough for a few state changes published in the same loop, lookups are a linear scan.
+  static constexpr uint8_t SIZE = 8;
+
+  struct Entry {
+    EntityBase *entity{nullptr};
+    uint16_t message_type{0};
+    uint32_t state_generation{0};
+    std::vector<uint8_t> data;  ///< Keeps its capacity when the entry is replaced
+  };
+
+  Entry entries_[SIZE];
+  uint8_t next_{0};
+};
+
+}  // namespace api
+}  // namespace esphome
+#endif
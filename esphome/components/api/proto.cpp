@@ -36,6 +36,20 @@ void ProtoMessage::decode(const uint8_t *buffer, size_t length) {
         i += consumed;
         break;
       }
+      case 1: {  // 64-bit
+        if (length - i < 8) {
+          ESP_LOGV(TAG, "Out-of-bounds Fixed64-bit at %" PRIu32, i);
+          error = true;
+          break;
+        }
+        uint64_t val = (uint64_t(encode_uint32(buffer[i + 7], buffer[i + 6], buffer[i + 5], buffer[i + 4])) << 32) |
+                       encode_uint32(buffer[i + 3], buffer[i + 2], buffer[i + 1], buffer[i]);
+        if (!this->decode_64bit(field_id, Proto64Bit(val))) {
+          ESP_LOGV(TAG, "Cannot decode 64-bit field %" PRIu32 "!", field_id);
+        }
+        i += 8;
+        break;
+      }
       case 2: {  // Length-delimited
         res = ProtoVarInt::parse(&buffer[i], length - i, &consumed);
         if (!res.has_value()) {
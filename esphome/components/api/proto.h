@@ -87,6 +87,17 @@ class ProtoVarInt {
       }
     }
   }
+  /// Encode into `out`, which must have room for the encoded value. Returns the number of bytes written.
+  size_t encode_to(uint8_t *out) const {
+    uint64_t val = this->value_;
+    size_t len = 0;
+    do {
+      uint8_t temp = val & 0x7F;
+      val >>= 7;
+      out[len++] = val ? temp | 0x80 : temp;
+    } while (val);
+    return len;
+  }
 
  protected:
   uint64_t value_;
@@ -163,7 +174,7 @@ class ProtoWriteBuffer {
     this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -200,7 +211,7 @@ class ProtoWriteBuffer {
     if (value == 0 && !force)
       return;
 
-    this->encode_field_raw(field_id, 5);
+    this->encode_field_raw(field_id, 1);
     this->write((value >> 0) & 0xFF);
     this->write((value >> 8) & 0xFF);
     this->write((value >> 16) & 0xFF);
@@ -222,7 +233,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, true);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -255,15 +266,11 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // Size the nested message up front, so that it can be written in place after its length
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -271,10 +278,110 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Calculates the encoded size of fields, mirroring the encode_* methods of ProtoWriteBuffer.
+ *
+ * The generated calculate_size() methods call these with the size of the field key precomputed, so that messages can
+ * be sized before encoding them into a buffer reserved up front.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < (1UL << 7))
+      return 1;
+    if (value < (1UL << 14))
+      return 2;
+    if (value < (1UL << 21))
+      return 3;
+    if (value < (1UL << 28))
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    if (value <= UINT32_MAX)
+      return varint(static_cast<uint32_t>(value));
+    uint32_t size = 5;
+    value >>= 35;
+    while (value) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      total_size += field_id_size + 10;
+      return;
+    }
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    uint32_t uvalue = value < 0 ? ~(value << 1) : value << 1;
+    add_uint32_field(total_size, field_id_size, uvalue, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    uint64_t uvalue = value < 0 ? ~(value << 1) : value << 1;
+    add_uint64_field(total_size, field_id_size, uvalue, force);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id_size, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field_id_size + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 8;
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id_size, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id_size, T value, bool force = false) {
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id_size, const std::string &value,
+                               bool force = false) {
+    if (value.empty() && !force)
+      return;
+    total_size += field_id_size + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id_size, const C &value, bool force = false) {
+    // encode_message() always writes the field, even for empty messages
+    uint32_t nested_size = 0;
+    value.calculate_size(nested_size);
+    total_size += field_id_size + varint(nested_size) + nested_size;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() writes for this message to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -298,12 +405,15 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Get an empty buffer to encode a message into, with room for at least reserve_size bytes.
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
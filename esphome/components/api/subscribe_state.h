@@ -5,6 +5,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/component_iterator.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/optional.h"
 namespace esphome {
 namespace api {
 
@@ -13,6 +14,8 @@ class APIConnection;
 class InitialStateIterator : public ComponentIterator {
  public:
   InitialStateIterator(APIConnection *client);
+  /// Only send entities whose state changed after this generation, empty sends every entity.
+  void set_since_generation(optional<uint32_t> since_generation) { this->since_generation_ = since_generation; }
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
@@ -76,8 +79,13 @@ class InitialStateIterator : public ComponentIterator {
 #ifdef USE_UPDATE
   bool on_update(update::UpdateEntity *update) override;
 #endif
+  bool on_end() override;
+
  protected:
+  bool is_unchanged_(EntityBase *entity) const;
+
   APIConnection *client_;
+  optional<uint32_t> since_generation_{};
 };
 
 }  // namespace api
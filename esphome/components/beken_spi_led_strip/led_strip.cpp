@@ -299,7 +299,7 @@ void BekenSPILEDStripLightOutput::write_state(light::LightState *state) {
   this->status_clear_warning();
 }
 
-light::ESPColorView BekenSPILEDStripLightOutput::get_view_internal(int32_t index) const {
+light::AddressableLight::PixelBuffer BekenSPILEDStripLightOutput::get_pixel_buffer() const {
   int32_t r = 0, g = 0, b = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
@@ -333,13 +333,25 @@ light::ESPColorView BekenSPILEDStripLightOutput::get_view_internal(int32_t index
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
-  uint8_t white = this->is_wrgb_ ? 0 : 3;
+  PixelBuffer buffer;
+  buffer.data = this->buf_;
+  buffer.effect_data = this->effect_data_;
+  buffer.stride = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
+  buffer.red = r + this->is_wrgb_;
+  buffer.green = g + this->is_wrgb_;
+  buffer.blue = b + this->is_wrgb_;
+  if (this->is_rgbw_ || this->is_wrgb_)
+    buffer.white = this->is_wrgb_ ? 0 : 3;
+  return buffer;
+}
 
-  return {this->buf_ + (index * multiplier) + r + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + g + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + b + this->is_wrgb_,
-          this->is_rgbw_ || this->is_wrgb_ ? this->buf_ + (index * multiplier) + white : nullptr,
+light::ESPColorView BekenSPILEDStripLightOutput::get_view_internal(int32_t index) const {
+  const PixelBuffer buffer = this->get_pixel_buffer();
+  uint8_t *pixel = buffer.data + index * buffer.stride;
+  return {pixel + buffer.red,
+          pixel + buffer.green,
+          pixel + buffer.blue,
+          buffer.white >= 0 ? pixel + buffer.white : nullptr,
           &this->effect_data_[index],
           &this->correction_};
 }
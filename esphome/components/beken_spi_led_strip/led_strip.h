@@ -56,6 +56,8 @@ class BekenSPILEDStripLightOutput : public light::AddressableLight {
 
   void dump_config() override;
 
+  PixelBuffer get_pixel_buffer() const override;
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
 
@@ -12,42 +12,60 @@ static const char *const TAG = "ct_clamp";
 void CTClampSensor::dump_config() {
   LOG_SENSOR("", "CT Clamp Sensor", this);
   ESP_LOGCONFIG(TAG, "  Sample Duration: %.2fs", this->sample_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Continuous: %s", YESNO(this->is_continuous_()));
   LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Voltage", this->voltage_sensor_);
+  LOG_SENSOR("  ", "Power", this->power_sensor_);
+  LOG_SENSOR("  ", "Apparent Power", this->apparent_power_sensor_);
+  LOG_SENSOR("  ", "Power Factor", this->power_factor_sensor_);
+}
+
+void CTClampSensor::setup() {
+  if (this->is_continuous_()) {
+    // The source delivers its samples on its own, no need to poll it from loop()
+    this->source_->add_on_samples_callback(
+        [this](const float *samples, size_t count) { this->add_samples_(samples, count); });
+    this->disable_loop();
+  }
 }
 
 void CTClampSensor::update() {
-  // Update only starts the sampling phase, in loop() the actual sampling is happening.
+  // Update only starts the sampling phase, in loop() or add_samples_() the actual sampling is happening.
 
   // Request a high loop() execution interval during sampling phase.
-  this->high_freq_.start();
+  if (!this->is_continuous_())
+    this->high_freq_.start();
 
   // Set timeout for ending sampling phase
   this->set_timeout("read", this->sample_duration_, [this]() {
     this->is_sampling_ = false;
-    this->high_freq_.stop();
+    if (!this->is_continuous_())
+      this->high_freq_.stop();
 
-    if (this->num_samples_ == 0) {
+    const voltage_sampler::PowerMeasurement measurement = this->analyzer_.finish();
+    if (measurement.samples == 0) {
       // Shouldn't happen, but let's not crash if it does.
       this->publish_state(NAN);
       return;
     }
 
-    const float rms_ac_dc_squared = this->sample_squared_sum_ / this->num_samples_;
-    const float rms_dc = this->sample_sum_ / this->num_samples_;
-    const float rms_ac_squared = rms_ac_dc_squared - rms_dc * rms_dc;
-    float rms_ac = 0;
-    if (rms_ac_squared > 0)
-      rms_ac = std::sqrt(rms_ac_squared);
     ESP_LOGD(TAG, "'%s' - Raw AC Value: %.3fA after %" PRIu32 " different samples (%" PRIu32 " SPS)",
-             this->name_.c_str(), rms_ac, this->num_samples_, 1000 * this->num_samples_ / this->sample_duration_);
-    this->publish_state(rms_ac);
+             this->name_.c_str(), measurement.current_rms, measurement.samples,
+             1000 * measurement.samples / this->sample_duration_);
+    this->publish_state(measurement.current_rms);
+    if (this->voltage_sensor_ != nullptr)
+      this->voltage_sensor_->publish_state(measurement.voltage_rms);
+    if (this->power_sensor_ != nullptr)
+      this->power_sensor_->publish_state(measurement.real_power);
+    if (this->apparent_power_sensor_ != nullptr)
+      this->apparent_power_sensor_->publish_state(measurement.apparent_power);
+    if (this->power_factor_sensor_ != nullptr)
+      this->power_factor_sensor_->publish_state(measurement.power_factor);
   });
 
   // Set sampling values
   this->last_value_ = 0.0;
-  this->num_samples_ = 0;
-  this->sample_sum_ = 0.0f;
-  this->sample_squared_sum_ = 0.0f;
+  this->analyzer_.finish();
   this->is_sampling_ = true;
 }
 
@@ -65,9 +83,19 @@ void CTClampSensor::loop() {
     return;
   this->last_value_ = value;
 
-  this->num_samples_++;
-  this->sample_sum_ += value;
-  this->sample_squared_sum_ += value * value;
+  if (this->voltage_source_ == nullptr) {
+    this->analyzer_.add(&value, 1);
+    return;
+  }
+  float voltage = this->voltage_source_->sample();
+  if (std::isnan(voltage))
+    return;
+  this->analyzer_.add(&value, &voltage, 1);
+}
+
+void CTClampSensor::add_samples_(const float *samples, size_t count) {
+  if (this->is_sampling_)
+    this->analyzer_.add(samples, count);
 }
 
 }  // namespace ct_clamp
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/voltage_sampler/power_analyzer.h"
 #include "esphome/components/voltage_sampler/voltage_sampler.h"
 
 namespace esphome {
@@ -10,6 +11,7 @@ namespace ct_clamp {
 
 class CTClampSensor : public sensor::Sensor, public PollingComponent {
  public:
+  void setup() override;
   void update() override;
   void loop() override;
   void dump_config() override;
@@ -20,8 +22,20 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
 
   void set_sample_duration(uint32_t sample_duration) { sample_duration_ = sample_duration; }
   void set_source(voltage_sampler::VoltageSampler *source) { source_ = source; }
+  /// Sample the voltage along with the current, for the voltage, power and power factor sensors.
+  void set_voltage_source(voltage_sampler::VoltageSampler *voltage_source) { voltage_source_ = voltage_source; }
+  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { voltage_sensor_ = voltage_sensor; }
+  void set_power_sensor(sensor::Sensor *power_sensor) { power_sensor_ = power_sensor; }
+  void set_apparent_power_sensor(sensor::Sensor *apparent_power_sensor) {
+    apparent_power_sensor_ = apparent_power_sensor;
+  }
+  void set_power_factor_sensor(sensor::Sensor *power_factor_sensor) { power_factor_sensor_ = power_factor_sensor; }
 
  protected:
+  /// Whether the samples come from the samples callback of the source instead of polling in loop().
+  bool is_continuous_() const { return this->voltage_source_ == nullptr && this->source_->is_continuous(); }
+  void add_samples_(const float *samples, size_t count);
+
   /// High Frequency loop() requester used during sampling phase.
   HighFrequencyLoopRequester high_freq_;
 
@@ -29,24 +43,25 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
   uint32_t sample_duration_;
   /// The sampling source to read values from.
   voltage_sampler::VoltageSampler *source_;
+  /// The sampling source for the voltage, sampled right after every current sample.
+  voltage_sampler::VoltageSampler *voltage_source_{nullptr};
+
+  sensor::Sensor *voltage_sensor_{nullptr};
+  sensor::Sensor *power_sensor_{nullptr};
+  sensor::Sensor *apparent_power_sensor_{nullptr};
+  sensor::Sensor *power_factor_sensor_{nullptr};
 
-  /** The DC offset of the circuit.
+  /** Computes the RMS of the AC part of the samples, and the power when the voltage is sampled too.
    *
    * Diagram: https://learn.openenergymonitor.org/electricity-monitoring/ct-sensors/interface-with-arduino
    *
    * The current clamp only measures AC, so any DC component is an unwanted artifact from the
-   * sampling circuit. The AC component is essentially the same as the calculating the Standard-Deviation,
-   * which can be done by cumulating 3 values per sample:
-   *   1) Number of samples
-   *   2) Sum of samples
-   *   3) Sum of sample squared
+   * sampling circuit. The AC component is essentially the same as the calculating the Standard-Deviation.
    * https://en.wikipedia.org/wiki/Root_mean_square
    */
+  voltage_sampler::PowerAnalyzer analyzer_;
 
   float last_value_ = 0.0f;
-  float sample_sum_ = 0.0f;
-  float sample_squared_sum_ = 0.0f;
-  uint32_t num_samples_ = 0;
   bool is_sampling_ = false;
 };
 
@@ -2,21 +2,44 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, voltage_sampler
 from esphome.const import (
+    CONF_APPARENT_POWER,
+    CONF_POWER,
+    CONF_POWER_FACTOR,
     CONF_SENSOR,
+    CONF_VOLTAGE,
+    DEVICE_CLASS_APPARENT_POWER,
     DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_POWER,
+    DEVICE_CLASS_POWER_FACTOR,
+    DEVICE_CLASS_VOLTAGE,
     STATE_CLASS_MEASUREMENT,
     UNIT_AMPERE,
+    UNIT_VOLT,
+    UNIT_VOLT_AMPS,
+    UNIT_WATT,
 )
 
 AUTO_LOAD = ["voltage_sampler"]
 CODEOWNERS = ["@jesserockz"]
 
 CONF_SAMPLE_DURATION = "sample_duration"
+CONF_VOLTAGE_SENSOR = "voltage_sensor"
 
 ct_clamp_ns = cg.esphome_ns.namespace("ct_clamp")
 CTClampSensor = ct_clamp_ns.class_("CTClampSensor", sensor.Sensor, cg.PollingComponent)
 
-CONFIG_SCHEMA = (
+VOLTAGE_SENSORS = [CONF_VOLTAGE, CONF_POWER, CONF_APPARENT_POWER, CONF_POWER_FACTOR]
+
+
+def validate_voltage_sensors(config):
+    if CONF_VOLTAGE_SENSOR not in config:
+        for key in VOLTAGE_SENSORS:
+            if key in config:
+                raise cv.Invalid(f"{key} requires {CONF_VOLTAGE_SENSOR}", path=[key])
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
     sensor.sensor_schema(
         CTClampSensor,
         unit_of_measurement=UNIT_AMPERE,
@@ -30,9 +53,34 @@ CONFIG_SCHEMA = (
             cv.Optional(
                 CONF_SAMPLE_DURATION, default="200ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_VOLTAGE_SENSOR): cv.use_id(voltage_sampler.VoltageSampler),
+            cv.Optional(CONF_VOLTAGE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_VOLT,
+                accuracy_decimals=2,
+                device_class=DEVICE_CLASS_VOLTAGE,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_POWER): sensor.sensor_schema(
+                unit_of_measurement=UNIT_WATT,
+                accuracy_decimals=2,
+                device_class=DEVICE_CLASS_POWER,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_APPARENT_POWER): sensor.sensor_schema(
+                unit_of_measurement=UNIT_VOLT_AMPS,
+                accuracy_decimals=2,
+                device_class=DEVICE_CLASS_APPARENT_POWER,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_POWER_FACTOR): sensor.sensor_schema(
+                accuracy_decimals=2,
+                device_class=DEVICE_CLASS_POWER_FACTOR,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
         }
     )
-    .extend(cv.polling_component_schema("60s"))
+    .extend(cv.polling_component_schema("60s")),
+    validate_voltage_sensors,
 )
 
 
@@ -43,3 +91,19 @@ async def to_code(config):
     sens = await cg.get_variable(config[CONF_SENSOR])
     cg.add(var.set_source(sens))
     cg.add(var.set_sample_duration(config[CONF_SAMPLE_DURATION]))
+
+    if CONF_VOLTAGE_SENSOR in config:
+        voltage = await cg.get_variable(config[CONF_VOLTAGE_SENSOR])
+        cg.add(var.set_voltage_source(voltage))
+    if voltage_config := config.get(CONF_VOLTAGE):
+        sens = await sensor.new_sensor(voltage_config)
+        cg.add(var.set_voltage_sensor(sens))
+    if power_config := config.get(CONF_POWER):
+        sens = await sensor.new_sensor(power_config)
+        cg.add(var.set_power_sensor(sens))
+    if apparent_power_config := config.get(CONF_APPARENT_POWER):
+        sens = await sensor.new_sensor(apparent_power_config)
+        cg.add(var.set_apparent_power_sensor(sens))
+    if power_factor_config := config.get(CONF_POWER_FACTOR):
+        sens = await sensor.new_sensor(power_factor_config)
+        cg.add(var.set_power_factor_sensor(sens))
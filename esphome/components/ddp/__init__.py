@@ -0,0 +1,51 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components.light.types import AddressableLightEffect
+from esphome.components.light.effects import register_addressable_effect
+from esphome.const import CONF_ID, CONF_NAME, CONF_CHANNELS
+
+AUTO_LOAD = ["socket"]
+DEPENDENCIES = ["network"]
+
+ddp_ns = cg.esphome_ns.namespace("ddp")
+DDPAddressableLightEffect = ddp_ns.class_(
+    "DDPAddressableLightEffect", AddressableLightEffect
+)
+DDPComponent = ddp_ns.class_("DDPComponent", cg.Component)
+
+CHANNELS = {
+    "MONO": 1,
+    "RGB": 3,
+    "RGBW": 4,
+}
+
+CONF_DDP_ID = "ddp_id"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(DDPComponent),
+    }
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+
+@register_addressable_effect(
+    "ddp",
+    DDPAddressableLightEffect,
+    "DDP",
+    {
+        cv.GenerateID(CONF_DDP_ID): cv.use_id(DDPComponent),
+        cv.Optional(CONF_CHANNELS, default="RGB"): cv.one_of(*CHANNELS, upper=True),
+    },
+)
+async def ddp_light_effect_to_code(config, effect_id):
+    parent = await cg.get_variable(config[CONF_DDP_ID])
+
+    effect = cg.new_Pvariable(effect_id, config[CONF_NAME])
+    cg.add(effect.set_channels(CHANNELS[config[CONF_CHANNELS]]))
+    cg.add(effect.set_ddp(parent))
+    return effect
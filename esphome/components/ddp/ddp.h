@@ -0,0 +1,42 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_NETWORK
+#include "esphome/components/socket/socket.h"
+#include "esphome/core/component.h"
+
+#include <memory>
+#include <set>
+
+namespace esphome {
+namespace ddp {
+
+class DDPAddressableLightEffect;
+
+/// The pixel data of a received DDP (Distributed Display Protocol) packet, which is not copied out of the receive
+/// buffer.
+struct DDPPacket {
+  uint32_t offset;      ///< Position of the data in the channel data of the display, in bytes
+  uint16_t length;      ///< Bytes of data
+  bool push;            ///< Last packet of a frame, the display should show the data now
+  const uint8_t *data;  ///< Valid until the next packet is read
+};
+
+class DDPComponent : public esphome::Component {
+ public:
+  void setup() override;
+  void loop() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void add_effect(DDPAddressableLightEffect *light_effect);
+  void remove_effect(DDPAddressableLightEffect *light_effect);
+
+ protected:
+  static bool packet_(const uint8_t *data, size_t len, DDPPacket &packet);
+
+  std::unique_ptr<socket::Socket> socket_;
+  std::set<DDPAddressableLightEffect *> light_effects_;
+};
+
+}  // namespace ddp
+}  // namespace esphome
+#endif
@@ -0,0 +1,53 @@
+#include "ddp_addressable_light_effect.h"
+#include "ddp.h"
+#ifdef USE_NETWORK
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ddp {
+
+static const char *const TAG = "ddp_addressable_light_effect";
+
+DDPAddressableLightEffect::DDPAddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
+
+void DDPAddressableLightEffect::start() {
+  AddressableLightEffect::start();
+
+  if (this->ddp_) {
+    this->ddp_->add_effect(this);
+  }
+}
+
+void DDPAddressableLightEffect::stop() {
+  if (this->ddp_) {
+    this->ddp_->remove_effect(this);
+  }
+
+  AddressableLightEffect::stop();
+}
+
+void DDPAddressableLightEffect::apply(light::AddressableLight &it, const Color &current_color) {
+  // ignore, it is run by `DDPComponent::loop()`
+}
+
+void DDPAddressableLightEffect::process_(const DDPPacket &packet) {
+  auto *it = this->get_addressable_();
+
+  // Only whole lights are applied. Common senders split the data into packets of 1440 bytes, a multiple of both 3 and
+  // 4, so a light split over two packets doesn't occur in practice.
+  const uint32_t first = (packet.offset + this->channels_ - 1) / this->channels_;
+  const uint32_t end =
+      std::min<uint32_t>(it->size(), (static_cast<uint64_t>(packet.offset) + packet.length) / this->channels_);
+
+  ESP_LOGV(TAG, "Applying data for '%s', for %" PRIu32 "-%" PRIu32 ".", this->get_name().c_str(), first, end);
+
+  if (first < end)
+    it->range(first, end).copy_from(packet.data + (first * this->channels_ - packet.offset), this->channels_);
+
+  if (packet.push)
+    it->schedule_show();
+}
+
+}  // namespace ddp
+}  // namespace esphome
+#endif
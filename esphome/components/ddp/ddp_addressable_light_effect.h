@@ -0,0 +1,35 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/light/addressable_light_effect.h"
+#ifdef USE_NETWORK
+namespace esphome {
+namespace ddp {
+
+class DDPComponent;
+struct DDPPacket;
+
+class DDPAddressableLightEffect : public light::AddressableLightEffect {
+ public:
+  DDPAddressableLightEffect(const std::string &name);
+
+  void start() override;
+  void stop() override;
+  void apply(light::AddressableLight &it, const Color &current_color) override;
+
+  /// Set the bytes of channel data per light: 1 (mono), 3 (RGB) or 4 (RGBW).
+  void set_channels(uint8_t channels) { this->channels_ = channels; }
+  void set_ddp(DDPComponent *ddp) { this->ddp_ = ddp; }
+
+ protected:
+  void process_(const DDPPacket &packet);
+
+  uint8_t channels_{3};
+  DDPComponent *ddp_{nullptr};
+
+  friend class DDPComponent;
+};
+
+}  // namespace ddp
+}  // namespace esphome
+#endif
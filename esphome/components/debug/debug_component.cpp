@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -21,6 +22,7 @@ void DebugComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Debug component:");
 #ifdef USE_TEXT_SENSOR
   LOG_TEXT_SENSOR("  ", "Device info", this->device_info_);
+  LOG_TEXT_SENSOR("  ", "Slowest component", this->slowest_component_);
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Free space on heap", this->free_sensor_);
@@ -28,6 +30,10 @@ void DebugComponent::dump_config() {
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+  LOG_SENSOR("  ", "Scheduler high water mark", this->scheduler_high_water_mark_sensor_);
+  LOG_SENSOR("  ", "Scheduler heap allocations", this->scheduler_heap_allocations_sensor_);
+  LOG_SENSOR("  ", "Callback heap allocations", this->callback_heap_allocations_sensor_);
+  LOG_SENSOR("  ", "Slowest component time", this->slowest_component_time_sensor_);
 #endif  // USE_SENSOR
 
   std::string device_info;
@@ -38,6 +44,14 @@ void DebugComponent::dump_config() {
   this->free_heap_ = get_free_heap_();
   ESP_LOGD(TAG, "Free Heap Size: %" PRIu32 " bytes", this->free_heap_);
 
+  auto pool = App.scheduler.get_pool_stats();
+  ESP_LOGD(TAG, "Scheduler: %" PRIu32 " items (max %" PRIu32 "), %" PRIu32 " item and %" PRIu32
+           " callback heap allocations",
+           pool.in_use, pool.high_water_mark, pool.item_allocations, pool.callback_allocations);
+  auto callbacks = get_callback_stats();
+  ESP_LOGD(TAG, "Callbacks: %" PRIu32 " registered, %" PRIu32 " capture and %" PRIu32 " array heap allocations",
+           callbacks.callbacks, callbacks.capture_allocations, callbacks.array_allocations);
+
   get_device_info_(device_info);
 
 #ifdef USE_TEXT_SENSOR
@@ -83,10 +97,64 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 
+  if (this->scheduler_high_water_mark_sensor_ != nullptr || this->scheduler_heap_allocations_sensor_ != nullptr) {
+    auto pool = App.scheduler.get_pool_stats();
+    if (this->scheduler_high_water_mark_sensor_ != nullptr)
+      this->scheduler_high_water_mark_sensor_->publish_state(pool.high_water_mark);
+    if (this->scheduler_heap_allocations_sensor_ != nullptr)
+      this->scheduler_heap_allocations_sensor_->publish_state(pool.item_allocations + pool.callback_allocations);
+  }
+  if (this->callback_heap_allocations_sensor_ != nullptr) {
+    auto callbacks = get_callback_stats();
+    this->callback_heap_allocations_sensor_->publish_state(callbacks.capture_allocations + callbacks.array_allocations);
+  }
+
 #endif  // USE_SENSOR
+#ifdef USE_LOOP_PROFILER
+  this->update_loop_profile_();
+#endif
   update_platform_();
 }
 
+#ifdef USE_LOOP_PROFILER
+void DebugComponent::update_loop_profile_() {
+  // The component that spent the most time on the main loop since boot
+  const Component *slowest = nullptr;
+  uint64_t slowest_total_us = 0;
+  for (const Component *component : App.get_components()) {
+    const ComponentProfile *profile = component->get_profile();
+    if (profile == nullptr)
+      continue;
+    ESP_LOGV(TAG, "%s: setup %" PRIu32 " us, loop %" PRIu32 "x avg=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32
+             " us, scheduler %" PRIu32 "x avg=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us",
+             component->get_component_source(), profile->setup_us, profile->loop.get_count(),
+             profile->loop.get_average_us(), profile->loop.get_percentile_us(0.99f), profile->loop.get_max_us(),
+             profile->scheduler.get_count(), profile->scheduler.get_average_us(),
+             profile->scheduler.get_percentile_us(0.99f), profile->scheduler.get_max_us());
+    uint64_t total_us = profile->loop.get_total_us() + profile->scheduler.get_total_us();
+    if (slowest == nullptr || total_us > slowest_total_us) {
+      slowest = component;
+      slowest_total_us = total_us;
+    }
+  }
+  if (slowest == nullptr)
+    return;
+
+  const ComponentProfile *profile = slowest->get_profile();
+  uint32_t p99_us = std::max(profile->loop.get_percentile_us(0.99f), profile->scheduler.get_percentile_us(0.99f));
+  ESP_LOGD(TAG, "Slowest component: %s (%" PRIu32 " ms total, p99 %" PRIu32 " us)", slowest->get_component_source(),
+           static_cast<uint32_t>(slowest_total_us / 1000), p99_us);
+#ifdef USE_SENSOR
+  if (this->slowest_component_time_sensor_ != nullptr)
+    this->slowest_component_time_sensor_->publish_state(p99_us / 1000.0f);
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->slowest_component_ != nullptr)
+    this->slowest_component_->publish_state(slowest->get_component_source());
+#endif  // USE_TEXT_SENSOR
+}
+#endif  // USE_LOOP_PROFILER
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
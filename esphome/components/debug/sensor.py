@@ -12,12 +12,17 @@ from esphome.const import (
     UNIT_BYTES,
     ICON_COUNTER,
     ICON_TIMER,
+    STATE_CLASS_TOTAL_INCREASING,
 )
 from . import CONF_DEBUG_ID, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
+CONF_CALLBACK_HEAP_ALLOCATIONS = "callback_heap_allocations"
 CONF_PSRAM = "psram"
+CONF_SCHEDULER_HEAP_ALLOCATIONS = "scheduler_heap_allocations"
+CONF_SCHEDULER_HIGH_WATER_MARK = "scheduler_high_water_mark"
+CONF_SLOWEST_COMPONENT_TIME = "slowest_component_time"
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +54,29 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_SCHEDULER_HIGH_WATER_MARK): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_SCHEDULER_HEAP_ALLOCATIONS): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_CALLBACK_HEAP_ALLOCATIONS): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_SLOWEST_COMPONENT_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +109,23 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if high_water_mark_conf := config.get(CONF_SCHEDULER_HIGH_WATER_MARK):
+        sens = await sensor.new_sensor(high_water_mark_conf)
+        cg.add(debug_component.set_scheduler_high_water_mark_sensor(sens))
+
+    if heap_allocations_conf := config.get(CONF_SCHEDULER_HEAP_ALLOCATIONS):
+        sens = await sensor.new_sensor(heap_allocations_conf)
+        cg.add(debug_component.set_scheduler_heap_allocations_sensor(sens))
+
+    if callback_allocations_conf := config.get(CONF_CALLBACK_HEAP_ALLOCATIONS):
+        sens = await sensor.new_sensor(callback_allocations_conf)
+        cg.add(debug_component.set_callback_heap_allocations_sensor(sens))
+
+    if slowest_component_time_conf := config.get(CONF_SLOWEST_COMPONENT_TIME):
+        sens = await sensor.new_sensor(slowest_component_time_conf)
+        cg.add(debug_component.set_slowest_component_time_sensor(sens))
+        cg.add_define("USE_LOOP_PROFILER")
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
@@ -8,6 +8,7 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+static const int MAX_PACKETS_PER_LOOP = 32;
 
 E131Component::E131Component() {}
 
@@ -53,26 +54,99 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
+  // A frame of a large display spans many universes, while the network stack only queues a few packets. Handle all
+  // of them, so that they aren't dropped while waiting for the next loop iteration.
+  for (int i = 0; i < MAX_PACKETS_PER_LOOP; i++) {
+    // Data of the next frame must not get into the buffers of the lights before they wrote the current one
+    if (this->is_frame_pending_()) {
+      return;
+    }
+
+    const bool deferred = this->pending_len_ != 0;
+    if (!deferred) {
+      ssize_t len = this->socket_->read(this->buf_, sizeof(this->buf_));
+      if (len <= 0) {
+        return;
+      }
+      this->pending_len_ = len;
+    }
+
+    if (!this->handle_packet_(this->pending_len_, !deferred)) {
+      return;
+    }
+    this->pending_len_ = 0;
+  }
+}
+
+bool E131Component::handle_packet_(size_t len, bool check_sequence) {
   E131Packet packet;
   int universe = 0;
-  uint8_t buf[1460];
 
-  ssize_t len = this->socket_->read(buf, sizeof(buf));
-  if (len == -1) {
-    return;
+  if (this->packet_(this->buf_, len, universe, packet)) {
+    if (check_sequence && this->is_stale_(this->universe_sequences_, universe, packet.sequence)) {
+      ESP_LOGV(TAG, "Discarded stale packet for %d universe.", universe);
+      return true;
+    }
+
+    if (packet.sync_universe != 0 && this->sync_universes_.insert(packet.sync_universe).second) {
+      this->join_(packet.sync_universe);
+    }
+
+    // A universe that already is part of the frame being assembled starts the next frame, which means the sender
+    // skipped universes or a sync packet got lost. The current frame is written first.
+    bool finished = false;
+    for (auto *light_effect : light_effects_) {
+      finished = light_effect->finish_frame_if_received_(universe) || finished;
+    }
+    if (finished) {
+      return false;
+    }
+
+    if (!this->process_(universe, packet)) {
+      ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+    }
+    return true;
   }
-  payload.resize(len);
-  memmove(&payload[0], buf, len);
 
-  if (!this->packet_(payload, universe, packet)) {
-    ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
-    return;
+  uint8_t sequence = 0;
+  if (this->sync_packet_(this->buf_, len, universe, sequence)) {
+    if (check_sequence && this->is_stale_(this->sync_sequences_, universe, sequence)) {
+      ESP_LOGV(TAG, "Discarded stale sync packet for %d universe.", universe);
+      return true;
+    }
+
+    ESP_LOGV(TAG, "Received E1.31 sync packet for %d universe", universe);
+    for (auto *light_effect : light_effects_) {
+      light_effect->process_sync_(universe);
+    }
+    return true;
   }
 
-  if (!this->process_(universe, packet)) {
-    ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+  ESP_LOGV(TAG, "Invalid packet received of size %zu.", len);
+  return true;
+}
+
+bool E131Component::is_stale_(std::map<int, uint8_t> &sequences, int universe, uint8_t sequence) {
+  auto it = sequences.find(universe);
+  if (it != sequences.end()) {
+    // As in the standard: a packet is out of order if it's at most 20 sequence numbers behind the last one, a larger
+    // difference means that the sender restarted.
+    auto diff = static_cast<int8_t>(sequence - it->second);
+    if (diff <= 0 && diff > -20) {
+      return true;
+    }
+  }
+  sequences[universe] = sequence;
+  return false;
+}
+
+bool E131Component::is_frame_pending_() const {
+  for (auto *light_effect : light_effects_) {
+    if (light_effect->is_frame_pending_()) {
+      return true;
+    }
   }
+  return false;
 }
 
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
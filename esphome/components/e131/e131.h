@@ -18,10 +18,14 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+const size_t E131_MAX_PACKET_SIZE = 638;
 
+/// The property values of a received E1.31 packet, which are not copied out of the receive buffer.
 struct E131Packet {
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  uint8_t sequence;
+  uint16_t sync_universe;  ///< Universe of the sync packets showing this data, 0 to show it once the frame is complete
+  const uint8_t *values;   ///< Start code followed by the channel data, valid until the next packet is read
 };
 
 class E131Component : public esphome::Component {
@@ -39,7 +43,13 @@ class E131Component : public esphome::Component {
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  bool packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet);
+  bool sync_packet_(const uint8_t *data, size_t len, int &sync_universe, uint8_t &sequence);
+  /// Handle the packet in buf_, returns false if it has to wait until the lights have written their current frame.
+  bool handle_packet_(size_t len, bool check_sequence);
+  /// Whether `sequence` is older than the last one received for `universe`, which is updated otherwise.
+  bool is_stale_(std::map<int, uint8_t> &sequences, int universe, uint8_t sequence);
+  bool is_frame_pending_() const;
   bool process_(int universe, const E131Packet &packet);
   bool join_igmp_groups_();
   void join_(int universe);
@@ -49,7 +59,11 @@ class E131Component : public esphome::Component {
   std::unique_ptr<socket::Socket> socket_;
   std::set<E131AddressableLightEffect *> light_effects_;
   std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  std::map<int, uint8_t> universe_sequences_;
+  std::map<int, uint8_t> sync_sequences_;
+  std::set<int> sync_universes_;  ///< Sync universes that have been joined
+  uint8_t buf_[E131_MAX_PACKET_SIZE];
+  size_t pending_len_{0};  ///< Length of the packet in buf_ that still has to be handled
 };
 
 }  // namespace e131
@@ -7,7 +7,7 @@ namespace esphome {
 namespace e131 {
 
 static const char *const TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = (E131_MAX_PROPERTY_VALUES_COUNT - 1);
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -28,6 +28,10 @@ int E131AddressableLightEffect::get_universe_count() const {
 void E131AddressableLightEffect::start() {
   AddressableLightEffect::start();
 
+  this->received_.assign(this->get_universe_count(), false);
+  this->received_count_ = 0;
+  this->sync_universe_ = 0;
+
   if (this->e131_) {
     this->e131_->add_effect(this);
   }
@@ -54,41 +58,56 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   int32_t output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end =
-      std::min(it->size(), std::min(output_offset + get_lights_per_universe(), output_offset + packet.count - 1));
+  int output_end = std::min(it->size(), std::min(output_offset + get_lights_per_universe(),
+                                                 output_offset + (packet.count - 1) / channels_));
   auto *input_data = packet.values + 1;
 
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %" PRId32 "-%d.", get_name().c_str(), universe,
            output_offset, output_end);
 
-  switch (channels_) {
-    case E131_MONO:
-      for (; output_offset < output_end; output_offset++, input_data++) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[0], input_data[0], input_data[0]));
-      }
-      break;
-
-    case E131_RGB:
-      for (; output_offset < output_end; output_offset++, input_data += 3) {
-        auto output = (*it)[output_offset];
-        output.set(
-            Color(input_data[0], input_data[1], input_data[2], (input_data[0] + input_data[1] + input_data[2]) / 3));
-      }
-      break;
-
-    case E131_RGBW:
-      for (; output_offset < output_end; output_offset++, input_data += 4) {
-        auto output = (*it)[output_offset];
-        output.set(Color(input_data[0], input_data[1], input_data[2], input_data[3]));
-      }
-      break;
+  // the light converts and corrects the channel data straight into its buffer
+  if (output_offset < output_end)
+    it->range(output_offset, output_end).copy_from(input_data, channels_);
+
+  const size_t index = universe - first_universe_;
+  if (index < this->received_.size() && !this->received_[index]) {
+    this->received_[index] = true;
+    this->received_count_++;
   }
+  this->sync_universe_ = packet.sync_universe;
 
-  it->schedule_show();
+  // without synchronization, the frame is shown as soon as all universes are received
+  if (this->sync_universe_ == 0 && this->received_count_ == static_cast<int>(this->received_.size()))
+    this->finish_frame_();
   return true;
 }
 
+void E131AddressableLightEffect::process_sync_(int sync_universe) {
+  if (this->sync_universe_ != 0 && sync_universe == this->sync_universe_)
+    this->finish_frame_();
+}
+
+bool E131AddressableLightEffect::finish_frame_if_received_(int universe) {
+  if (universe < first_universe_ || universe > get_last_universe())
+    return false;
+
+  const size_t index = universe - first_universe_;
+  if (index >= this->received_.size() || !this->received_[index])
+    return false;
+
+  this->finish_frame_();
+  return true;
+}
+
+void E131AddressableLightEffect::finish_frame_() {
+  if (this->received_count_ == 0)
+    return;
+
+  std::fill(this->received_.begin(), this->received_.end(), false);
+  this->received_count_ = 0;
+  this->get_addressable_()->schedule_show();
+}
+
 }  // namespace e131
 }  // namespace esphome
 #endif
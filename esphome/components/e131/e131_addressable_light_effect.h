@@ -2,6 +2,8 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/light/addressable_light_effect.h"
+
+#include <vector>
 #ifdef USE_NETWORK
 namespace esphome {
 namespace e131 {
@@ -31,11 +33,21 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
 
  protected:
   bool process_(int universe, const E131Packet &packet);
+  /// Show the frame being assembled if it's synchronized by `sync_universe`.
+  void process_sync_(int sync_universe);
+  /// Show the frame being assembled if `universe` already is part of it, returns whether it did.
+  bool finish_frame_if_received_(int universe);
+  void finish_frame_();
+  /// Whether a frame has been completed, but not written to the light yet.
+  bool is_frame_pending_() const { return this->get_addressable_()->is_show_scheduled(); }
 
   int first_universe_{0};
   int last_universe_{0};
   E131LightChannels channels_{E131_RGB};
   E131Component *e131_{nullptr};
+  std::vector<bool> received_;  ///< Universes received for the frame being assembled
+  int received_count_{0};
+  int sync_universe_{0};  ///< Sync universe of the frame being assembled, 0 when it isn't synchronized
 
   friend class E131Component;
 };
@@ -17,6 +17,9 @@ static const uint32_t RMT_CLK_FREQ = 80000000;
 
 static const uint8_t RMT_CLK_DIV = 2;
 
+/// Low time after a frame that makes the LEDs latch it, 50 µs.
+static const uint32_t LATCH_TICKS = RMT_CLK_FREQ / RMT_CLK_DIV / 1000000 * 50;
+
 void ESP32RMTLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 LED Strip...");
 
@@ -37,9 +40,25 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
-  RAMAllocator<rmt_item32_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_item32_t>::ALLOC_INTERNAL);
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 +
-                                          1);  // 8 bits per byte, 1 rmt_item32_t per bit + 1 rmt_item32_t for reset
+  if (this->double_buffer_) {
+    this->front_buf_ = allocator.allocate(buffer_size);
+    if (this->front_buf_ == nullptr) {
+      ESP_LOGE(TAG, "Cannot allocate front buffer!");
+      this->mark_failed();
+      return;
+    }
+    // write_state() doesn't wait before the next frame, so every frame has to end with the low time that latches it
+    if (!this->has_reset_()) {
+      this->reset_.duration0 = LATCH_TICKS / 2;
+      this->reset_.level0 = 0;
+      this->reset_.duration1 = LATCH_TICKS / 2;
+      this->reset_.level1 = 0;
+    }
+  } else {
+    RAMAllocator<rmt_item32_t> rmt_allocator(this->use_psram_ ? 0 : RAMAllocator<rmt_item32_t>::ALLOC_INTERNAL);
+    this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 +
+                                            1);  // 8 bits per byte, 1 rmt_item32_t per bit + 1 rmt_item32_t for reset
+  }
 
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
@@ -64,6 +83,12 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+  if (this->double_buffer_ && (rmt_translator_init(config.channel, ESP32RMTLEDStripLightOutput::translate_) != ESP_OK ||
+                               rmt_translator_set_context(config.channel, this) != ESP_OK)) {
+    ESP_LOGE(TAG, "Cannot initialize RMT translator!");
+    this->mark_failed();
+    return;
+  }
 }
 
 void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high,
@@ -95,11 +120,28 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
     this->schedule_show();
     return;
   }
+  if (this->double_buffer_ && rmt_wait_tx_done(this->channel_, 0) != ESP_OK) {
+    // the previous frame is still being sent, try again next loop iteration
+    this->schedule_show();
+    return;
+  }
   this->last_refresh_ = now;
   this->mark_shown_();
 
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
 
+  if (this->double_buffer_) {
+    // The RMT interrupt encodes the front buffer while it is sent, so buf_ is free for the next frame afterwards
+    memcpy(this->front_buf_, this->buf_, this->get_buffer_size_());
+    if (rmt_write_sample(this->channel_, this->front_buf_, this->get_buffer_size_(), false) != ESP_OK) {
+      ESP_LOGE(TAG, "RMT TX error");
+      this->status_set_warning();
+      return;
+    }
+    this->status_clear_warning();
+    return;
+  }
+
   if (rmt_wait_tx_done(this->channel_, pdMS_TO_TICKS(1000)) != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX timeout");
     this->status_set_warning();
@@ -138,7 +180,41 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   this->status_clear_warning();
 }
 
-light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::translate_(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                        size_t wanted_num, size_t *translated_size, size_t *item_num) {
+  ESP32RMTLEDStripLightOutput *light = nullptr;
+  if (src == nullptr || dest == nullptr ||
+      rmt_translator_get_context(item_num, reinterpret_cast<void **>(&light)) != ESP_OK) {
+    *translated_size = 0;
+    *item_num = 0;
+    return;
+  }
+  const bool reset = light->has_reset_();
+  const uint8_t *psrc = static_cast<const uint8_t *>(src);
+  size_t size = 0;
+  size_t num = 0;
+  // src_size counts the bytes that are left, so the reset is added after the last one
+  while (size < src_size) {
+    const bool last = size + 1 == src_size;
+    if (num + 8 + (last && reset) > wanted_num)
+      break;
+    uint8_t b = psrc[size];
+    for (int i = 0; i < 8; i++) {
+      dest->val = b & (1 << (7 - i)) ? light->bit1_.val : light->bit0_.val;
+      dest++;
+    }
+    num += 8;
+    size++;
+    if (last && reset) {
+      dest->val = light->reset_.val;
+      num++;
+    }
+  }
+  *translated_size = size;
+  *item_num = num;
+}
+
+light::AddressableLight::PixelBuffer ESP32RMTLEDStripLightOutput::get_pixel_buffer() const {
   int32_t r = 0, g = 0, b = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
@@ -172,13 +248,25 @@ light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
-  uint8_t white = this->is_wrgb_ ? 0 : 3;
+  PixelBuffer buffer;
+  buffer.data = this->buf_;
+  buffer.effect_data = this->effect_data_;
+  buffer.stride = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
+  buffer.red = r + this->is_wrgb_;
+  buffer.green = g + this->is_wrgb_;
+  buffer.blue = b + this->is_wrgb_;
+  if (this->is_rgbw_ || this->is_wrgb_)
+    buffer.white = this->is_wrgb_ ? 0 : 3;
+  return buffer;
+}
 
-  return {this->buf_ + (index * multiplier) + r + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + g + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + b + this->is_wrgb_,
-          this->is_rgbw_ || this->is_wrgb_ ? this->buf_ + (index * multiplier) + white : nullptr,
+light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+  const PixelBuffer buffer = this->get_pixel_buffer();
+  uint8_t *pixel = buffer.data + index * buffer.stride;
+  return {pixel + buffer.red,
+          pixel + buffer.green,
+          pixel + buffer.blue,
+          buffer.white >= 0 ? pixel + buffer.white : nullptr,
           &this->effect_data_[index],
           &this->correction_};
 }
@@ -214,6 +302,7 @@ void ESP32RMTLEDStripLightOutput::dump_config() {
   ESP_LOGCONFIG(TAG, "  RGB Order: %s", rgb_order);
   ESP_LOGCONFIG(TAG, "  Max refresh rate: %" PRIu32, *this->max_refresh_rate_);
   ESP_LOGCONFIG(TAG, "  Number of LEDs: %u", this->num_leds_);
+  ESP_LOGCONFIG(TAG, "  Double buffer: %s", YESNO(this->double_buffer_));
 }
 
 float ESP32RMTLEDStripLightOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
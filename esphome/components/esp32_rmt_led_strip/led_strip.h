@@ -46,6 +46,12 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
   void set_is_rgbw(bool is_rgbw) { this->is_rgbw_ = is_rgbw; }
   void set_is_wrgb(bool is_wrgb) { this->is_wrgb_ = is_wrgb; }
   void set_use_psram(bool use_psram) { this->use_psram_ = use_psram; }
+  /** Send a copy of the pixels, with the bits encoded by the RMT interrupt while they are clocked out.
+   *
+   * Instead of a buffer of RMT items (32 bytes per pixel byte), only a second copy of the pixels is needed, and
+   * write_state() returns right after copying them. Effects render the next frame into the pixel buffer meanwhile.
+   */
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
 
   /// Set a maximum refresh rate in µs as some lights do not like being updated too often.
   void set_max_refresh_rate(uint32_t interval_us) { this->max_refresh_rate_ = interval_us; }
@@ -63,20 +69,29 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
   void dump_config() override;
 
+  PixelBuffer get_pixel_buffer() const override;
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (this->is_rgbw_ || this->is_wrgb_ ? 4 : 3); }
+  bool has_reset_() const { return this->reset_.duration0 > 0 || this->reset_.duration1 > 0; }
+
+  /// RMT translator for double buffering, called from the RMT interrupt to encode the next part of the front buffer.
+  static void translate_(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                         size_t *translated_size, size_t *item_num);
 
   uint8_t *buf_{nullptr};
   uint8_t *effect_data_{nullptr};
   rmt_item32_t *rmt_buf_{nullptr};
+  uint8_t *front_buf_{nullptr};  ///< Copy of buf_ that is being sent, with double buffering
 
   uint8_t pin_;
   uint16_t num_leds_;
   bool is_rgbw_;
   bool is_wrgb_;
   bool use_psram_;
+  bool double_buffer_{false};
 
   rmt_item32_t bit0_, bit1_, reset_;
   RGBOrder rgb_order_;
@@ -56,6 +56,7 @@ CHIPSETS = {
 }
 
 CONF_USE_PSRAM = "use_psram"
+CONF_DOUBLE_BUFFER = "double_buffer"
 CONF_IS_WRGB = "is_wrgb"
 CONF_BIT0_HIGH = "bit0_high"
 CONF_BIT0_LOW = "bit0_low"
@@ -78,6 +79,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_IS_RGBW, default=False): cv.boolean,
             cv.Optional(CONF_IS_WRGB, default=False): cv.boolean,
             cv.Optional(CONF_USE_PSRAM, default=True): cv.boolean,
+            cv.Optional(CONF_DOUBLE_BUFFER, default=False): cv.boolean,
             cv.Inclusive(
                 CONF_BIT0_HIGH,
                 "custom",
@@ -147,6 +149,7 @@ async def to_code(config):
     cg.add(var.set_is_rgbw(config[CONF_IS_RGBW]))
     cg.add(var.set_is_wrgb(config[CONF_IS_WRGB]))
     cg.add(var.set_use_psram(config[CONF_USE_PSRAM]))
+    cg.add(var.set_double_buffer(config[CONF_DOUBLE_BUFFER]))
 
     cg.add(
         var.set_rmt_channel(
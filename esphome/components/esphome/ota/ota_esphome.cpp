@@ -67,6 +67,9 @@ void ESPHomeOTAComponent::setup() {
     this->mark_failed();
     return;
   }
+#ifdef USE_TICKLESS_LOOP
+  socket::set_wake_loop_on_readable(this->server_.get(), true);
+#endif
 }
 
 void ESPHomeOTAComponent::dump_config() {
@@ -104,8 +107,10 @@ void ESPHomeOTAComponent::handle_() {
     socklen_t addr_len = sizeof(source_addr);
     client_ = server_->accept((struct sockaddr *) &source_addr, &addr_len);
   }
-  if (client_ == nullptr)
+  if (client_ == nullptr) {
+    this->report_loop_idle();
     return;
+  }
 
   int enable = 1;
   int err = client_->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
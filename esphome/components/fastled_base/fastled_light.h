@@ -223,6 +223,17 @@ class FastLEDLightOutput : public light::AddressableLight {
       this->effect_data_[i] = 0;
   }
 
+  PixelBuffer get_pixel_buffer() const override {
+    PixelBuffer buffer;
+    buffer.data = reinterpret_cast<uint8_t *>(this->leds_);
+    buffer.effect_data = this->effect_data_;
+    buffer.stride = sizeof(CRGB);
+    buffer.red = 0;
+    buffer.green = 1;
+    buffer.blue = 2;
+    return buffer;
+  }
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
@@ -4,6 +4,8 @@
 #include "esphome/components/uart/uart.h"
 #include "esphome/core/component.h"
 
+#include <queue>
+
 namespace esphome {
 namespace kamstrup_kmp {
 
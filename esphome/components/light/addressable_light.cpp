@@ -6,6 +6,45 @@ namespace light {
 
 static const char *const TAG = "light.addressable";
 
+void AddressableLightState::setup() {
+  LightState::setup();
+  this->next_frame_ = micros();
+  this->reset_frame_stats();
+}
+
+void AddressableLightState::loop() {
+  const uint32_t now = micros();
+  if (this->frame_interval_ != 0) {
+    const uint32_t late = now - this->next_frame_;
+    if (static_cast<int32_t>(late) < 0)
+      return;
+    if (late >= this->frame_interval_) {
+      // don't catch up on missed frames, that would only delay the following ones as well
+      this->frame_stats_.dropped += late / this->frame_interval_;
+      this->next_frame_ = now + this->frame_interval_;
+    } else {
+      this->next_frame_ += this->frame_interval_;
+    }
+  }
+
+  this->render_();
+  const uint32_t rendered = micros();
+  this->frame_stats_.frames++;
+  this->frame_stats_.render_time += rendered - now;
+
+  if (this->next_write_) {
+    this->next_write_ = false;
+    this->output_->write_state(this);
+    this->frame_stats_.writes++;
+    this->frame_stats_.output_time += micros() - rendered;
+  }
+}
+
+void AddressableLightState::reset_frame_stats() {
+  this->frame_stats_ = {};
+  this->frame_stats_.start = millis();
+}
+
 void AddressableLight::call_setup() {
   this->setup();
 
@@ -95,13 +134,8 @@ optional<LightColorValues> AddressableLightTransformer::apply() {
   alpha255 = clamp(alpha255, 0.0f, 255.0f);
   auto alpha8 = static_cast<uint8_t>(alpha255);
 
-  if (alpha8 != 0) {
-    uint8_t inv_alpha8 = 255 - alpha8;
-    Color add = this->target_color_ * alpha8;
-
-    for (auto led : this->light_)
-      led.set(add + led.get() * inv_alpha8);
-  }
+  if (alpha8 != 0)
+    this->light_.all().blend(this->target_color_, alpha8);
 
   this->last_transition_progress_ = smoothed_progress;
   this->light_.schedule_show();
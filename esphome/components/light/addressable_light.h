@@ -25,12 +25,57 @@ Color color_from_light_color_values(LightColorValues val);
 /// Use a custom state class for addressable lights, to allow type system to discriminate between addressable and
 /// non-addressable lights.
 class AddressableLightState : public LightState {
+ public:
   using LightState::LightState;
+
+  /// Timing of the frames since the last reset_frame_stats().
+  struct FrameStats {
+    uint32_t frames{0};       ///< Frames rendered, every loop iteration without frame rate
+    uint32_t writes{0};       ///< Frames written to the output
+    uint32_t dropped{0};      ///< Frames skipped because the loop was late
+    uint32_t render_time{0};  ///< Total µs spent in effects and transitions
+    uint32_t output_time{0};  ///< Total µs spent writing to the output
+    uint32_t start{0};        ///< millis() at the reset
+  };
+
+  void setup() override;
+  void loop() override;
+
+  /** Render at most one frame per `frame_interval` µs, 0 (default) to render every loop iteration.
+   *
+   * The effect and transition are applied once per frame, right before the frame is written. When the loop is late by
+   * more than a frame, the missed frames are dropped instead of being rendered back to back.
+   */
+  void set_frame_interval(uint32_t frame_interval) { this->frame_interval_ = frame_interval; }
+  const FrameStats &get_frame_stats() const { return this->frame_stats_; }
+  void reset_frame_stats();
+
+ protected:
+  uint32_t frame_interval_{0};
+  uint32_t next_frame_{0};
+  FrameStats frame_stats_{};
 };
 
 class AddressableLight : public LightOutput, public Component {
  public:
+  /// Where the pixels of a light are stored, for operations on ranges that work on the buffer directly.
+  struct PixelBuffer {
+    uint8_t *data{nullptr};         ///< First pixel, nullptr if the pixels are not in one buffer of equal-sized pixels
+    uint8_t *effect_data{nullptr};  ///< Effect data of the first pixel, one byte per pixel
+    uint8_t stride{0};              ///< Bytes per pixel
+    uint8_t red{0};                 ///< Offset of the red channel in a pixel
+    uint8_t green{0};
+    uint8_t blue{0};
+    int8_t white{-1};  ///< Offset of the white channel in a pixel, -1 without white channel
+  };
+
   virtual int32_t size() const = 0;
+  /** Describe the pixel buffer, so that range operations (ESPRangeView) can loop over the bytes directly.
+   *
+   * Lights that don't store their pixels in one buffer, with the channels of each pixel at the same offsets, keep the
+   * default, and the range operations use get_view_internal() for every pixel instead.
+   */
+  virtual PixelBuffer get_pixel_buffer() const { return {}; }
   ESPColorView operator[](int32_t index) const { return this->get_view_internal(interpret_index(index, this->size())); }
   ESPColorView get(int32_t index) { return this->get_view_internal(interpret_index(index, this->size())); }
   virtual void clear_effect_data() = 0;
@@ -74,6 +119,8 @@ class AddressableLight : public LightOutput, public Component {
   }
   void update_state(LightState *state) override;
   void schedule_show() { this->state_parent_->next_write_ = true; }
+  /// Whether schedule_show() has been called since the output was last written.
+  bool is_show_scheduled() const { return this->state_parent_->next_write_; }
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -83,9 +130,23 @@ class AddressableLight : public LightOutput, public Component {
 
  protected:
   friend class AddressableLightTransformer;
+  friend class ESPRangeView;
 
   void mark_shown_() {
 #ifdef USE_POWER_SUPPLY
+    PixelBuffer buffer = this->get_pixel_buffer();
+    if (buffer.data != nullptr) {
+      const uint8_t *pixel = buffer.data;
+      for (int32_t i = 0; i < this->size(); i++, pixel += buffer.stride) {
+        if (pixel[buffer.red] > 0 || pixel[buffer.green] > 0 || pixel[buffer.blue] > 0 ||
+            (buffer.white >= 0 && pixel[buffer.white] > 0)) {
+          this->power_.request();
+          return;
+        }
+      }
+      this->power_.unrequest();
+      return;
+    }
     for (const auto &c : *this) {
       if (c.get_red_raw() > 0 || c.get_green_raw() > 0 || c.get_blue_raw() > 0 || c.get_white_raw() > 0) {
         this->power_.request();
@@ -1,11 +1,13 @@
 #include "esp_color_correction.h"
 #include "light_color_values.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace light {
 
 void ESPColorCorrection::calculate_gamma_table(float gamma) {
+  this->channel_tables_valid_ = false;
   for (uint16_t i = 0; i < 256; i++) {
     // corrected = val ^ gamma
     auto corrected = to_uint8_scale(gamma_correct(i / 255.0f, gamma));
@@ -23,5 +25,25 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+const ESPColorCorrection::ChannelTables &ESPColorCorrection::get_channel_tables() const {
+  if (this->channel_tables_valid_)
+    return *this->channel_tables_;
+  if (!this->channel_tables_)
+    this->channel_tables_ = make_unique<ChannelTables>();
+  auto &tables = *this->channel_tables_;
+  for (uint16_t i = 0; i < 256; i++) {
+    tables.correct[0][i] = this->color_correct_red(i);
+    tables.correct[1][i] = this->color_correct_green(i);
+    tables.correct[2][i] = this->color_correct_blue(i);
+    tables.correct[3][i] = this->color_correct_white(i);
+    tables.uncorrect[0][i] = this->color_uncorrect_red(i);
+    tables.uncorrect[1][i] = this->color_uncorrect_green(i);
+    tables.uncorrect[2][i] = this->color_uncorrect_blue(i);
+    tables.uncorrect[3][i] = this->color_uncorrect_white(i);
+  }
+  this->channel_tables_valid_ = true;
+  return tables;
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -2,15 +2,37 @@
 
 #include "esphome/core/color.h"
 
+#include <memory>
+
 namespace esphome {
 namespace light {
 
 class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  void set_max_brightness(const Color &max_brightness) {
+    this->max_brightness_ = max_brightness;
+    this->channel_tables_valid_ = false;
+  }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (local_brightness == this->local_brightness_)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->channel_tables_valid_ = false;
+  }
   void calculate_gamma_table(float gamma);
+
+  /// The results of color_correct_*() and color_uncorrect_*() for every value, per channel (red, green, blue, white).
+  struct ChannelTables {
+    uint8_t correct[4][256];
+    uint8_t uncorrect[4][256];
+  };
+  /** Get the correction of each channel as lookup tables, for loops over many pixels.
+   *
+   * The tables take 2 KiB, so they are only allocated on the first call. They are rebuilt on the first call after the
+   * brightness or gamma changed.
+   */
+  const ChannelTables &get_channel_tables() const;
   inline Color color_correct(Color color) const ESPHOME_ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
@@ -71,6 +93,8 @@ class ESPColorCorrection {
   uint8_t gamma_reverse_table_[256];
   Color max_brightness_;
   uint8_t local_brightness_{255};
+  mutable std::unique_ptr<ChannelTables> channel_tables_;
+  mutable bool channel_tables_valid_{false};
 };
 
 }  // namespace light
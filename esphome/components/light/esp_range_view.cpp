@@ -1,6 +1,8 @@
 #include "esp_range_view.h"
 #include "addressable_light.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
@@ -17,9 +19,125 @@ ESPColorView ESPRangeView::operator[](int32_t index) const {
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
+// The range operations below work on the pixel buffer directly when the light has one. Each channel then takes one
+// lookup in the correction tables, instead of an ESPColorView and the correction computations per pixel.
+
+template<typename F> void ESPRangeView::transform_(F &&transform) {
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data == nullptr) {
+    for (auto c : *this)
+      c.set(transform(c.get()));
+    return;
+  }
+  const auto &tables = this->parent_->correction_.get_channel_tables();
+  uint8_t *pixel = buffer.data + this->begin_ * buffer.stride;
+  for (int32_t i = this->begin_; i < this->end_; i++, pixel += buffer.stride) {
+    const uint8_t white = buffer.white >= 0 ? tables.uncorrect[3][pixel[buffer.white]] : 0;
+    Color color(tables.uncorrect[0][pixel[buffer.red]], tables.uncorrect[1][pixel[buffer.green]],
+                tables.uncorrect[2][pixel[buffer.blue]], white);
+    color = transform(color);
+    pixel[buffer.red] = tables.correct[0][color.r];
+    pixel[buffer.green] = tables.correct[1][color.g];
+    pixel[buffer.blue] = tables.correct[2][color.b];
+    if (buffer.white >= 0)
+      pixel[buffer.white] = tables.correct[3][color.w];
+  }
+}
+
 void ESPRangeView::set(const Color &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data == nullptr) {
+    for (int32_t i = this->begin_; i < this->end_; i++) {
+      (*this->parent_)[i] = color;
+    }
+    return;
+  }
+  const Color corrected = this->parent_->correction_.color_correct(color);
+  uint8_t *pixel = buffer.data + this->begin_ * buffer.stride;
+  for (int32_t i = this->begin_; i < this->end_; i++, pixel += buffer.stride) {
+    pixel[buffer.red] = corrected.r;
+    pixel[buffer.green] = corrected.g;
+    pixel[buffer.blue] = corrected.b;
+    if (buffer.white >= 0)
+      pixel[buffer.white] = corrected.w;
+  }
+}
+
+void ESPRangeView::blend(const Color &color, uint8_t alpha) {
+  const Color add = color * alpha;
+  const uint8_t inv_alpha = 255 - alpha;
+  this->transform_([add, inv_alpha](Color led) { return add + led * inv_alpha; });
+}
+void ESPRangeView::scale(uint8_t scale) {
+  this->transform_([scale](Color led) { return led * scale; });
+}
+
+void ESPRangeView::gradient(const Color &from, const Color &to) {
+  const int32_t last = this->size() - 1;
+  Color start = from;
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data == nullptr) {
+    for (int32_t i = 0; i <= last; i++)
+      (*this)[i] = start.gradient(to, last == 0 ? 0 : (i * 255) / last);
+    return;
+  }
+  const auto &tables = this->parent_->correction_.get_channel_tables();
+  uint8_t *pixel = buffer.data + this->begin_ * buffer.stride;
+  for (int32_t i = 0; i <= last; i++, pixel += buffer.stride) {
+    const Color color = start.gradient(to, last == 0 ? 0 : (i * 255) / last);
+    pixel[buffer.red] = tables.correct[0][color.r];
+    pixel[buffer.green] = tables.correct[1][color.g];
+    pixel[buffer.blue] = tables.correct[2][color.b];
+    if (buffer.white >= 0)
+      pixel[buffer.white] = tables.correct[3][color.w];
+  }
+}
+
+void ESPRangeView::copy_from(const Color *colors) {
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data == nullptr) {
+    for (int32_t i = 0; i < this->size(); i++)
+      (*this)[i] = colors[i];
+    return;
+  }
+  const auto &tables = this->parent_->correction_.get_channel_tables();
+  uint8_t *pixel = buffer.data + this->begin_ * buffer.stride;
+  for (int32_t i = 0; i < this->size(); i++, pixel += buffer.stride) {
+    pixel[buffer.red] = tables.correct[0][colors[i].r];
+    pixel[buffer.green] = tables.correct[1][colors[i].g];
+    pixel[buffer.blue] = tables.correct[2][colors[i].b];
+    if (buffer.white >= 0)
+      pixel[buffer.white] = tables.correct[3][colors[i].w];
+  }
+}
+
+static inline Color color_from_channels(const uint8_t *data, uint8_t channels) {
+  switch (channels) {
+    case 1:
+      return Color(data[0], data[0], data[0], data[0]);
+    case 3:
+      return Color(data[0], data[1], data[2], (data[0] + data[1] + data[2]) / 3);
+    default:
+      return Color(data[0], data[1], data[2], data[3]);
+  }
+}
+
+void ESPRangeView::copy_from(const uint8_t *data, uint8_t channels) {
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data == nullptr) {
+    for (int32_t i = 0; i < this->size(); i++, data += channels)
+      (*this)[i] = color_from_channels(data, channels);
+    return;
+  }
+  const auto &tables = this->parent_->correction_.get_channel_tables();
+  uint8_t *pixel = buffer.data + this->begin_ * buffer.stride;
+  for (int32_t i = 0; i < this->size(); i++, pixel += buffer.stride, data += channels) {
+    const Color color = color_from_channels(data, channels);
+    pixel[buffer.red] = tables.correct[0][color.r];
+    pixel[buffer.green] = tables.correct[1][color.g];
+    pixel[buffer.blue] = tables.correct[2][color.b];
+    if (buffer.white >= 0)
+      pixel[buffer.white] = tables.correct[3][color.w];
   }
 }
 
@@ -45,20 +163,16 @@ void ESPRangeView::set_effect_data(uint8_t effect_data) {
 }
 
 void ESPRangeView::fade_to_white(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_white(amnt);
+  this->transform_([amnt](Color led) { return led.fade_to_white(amnt); });
 }
 void ESPRangeView::fade_to_black(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_black(amnt);
+  this->transform_([amnt](Color led) { return led.fade_to_black(amnt); });
 }
 void ESPRangeView::lighten(uint8_t delta) {
-  for (auto c : *this)
-    c.lighten(delta);
+  this->transform_([delta](Color led) { return led.lighten(delta); });
 }
 void ESPRangeView::darken(uint8_t delta) {
-  for (auto c : *this)
-    c.darken(delta);
+  this->transform_([delta](Color led) { return led.darken(delta); });
 }
 ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   // If size doesn't match, error (todo warning)
@@ -75,6 +189,14 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {  // NOLINT
   if (rhs.begin_ == this->begin_)
     return *this;
 
+  const AddressableLight::PixelBuffer buffer = this->parent_->get_pixel_buffer();
+  if (buffer.data != nullptr) {
+    // Both ranges use the same correction, so the corrected values can be moved as they are
+    std::memmove(buffer.data + this->begin_ * buffer.stride, buffer.data + rhs.begin_ * buffer.stride,
+                 this->size() * buffer.stride);
+    return *this;
+  }
+
   if (rhs.begin_ > this->begin_) {
     // Copy from left
     for (int32_t i = 0; i < this->size(); i++) {
@@ -37,6 +37,20 @@ class ESPRangeView : public ESPColorSettable {
   void fade_to_black(uint8_t amnt) override;
   void lighten(uint8_t delta) override;
   void darken(uint8_t delta) override;
+  /// Mix `color` into every LED: `color * alpha + led * (255 - alpha)`.
+  void blend(const Color &color, uint8_t alpha);
+  /// Multiply every LED by `scale` / 255.
+  void scale(uint8_t scale);
+  /// Set the LEDs to a linear gradient from `from` at the first LED to `to` at the last one.
+  void gradient(const Color &from, const Color &to);
+  /// Set the LEDs to `colors`, which must have size() elements.
+  void copy_from(const Color *colors);
+  /** Set the LEDs from `channels` bytes per LED, like DMX channel data.
+   *
+   * With 1 channel all colors (white included) are set to the same level, with 3 channels white is set to the average
+   * of red, green and blue, and 4 channels are red, green, blue and white. `data` must have size() * `channels` bytes.
+   */
+  void copy_from(const uint8_t *data, uint8_t channels);
 
   ESPRangeView &operator=(const Color &rhs) {
     this->set(rhs);
@@ -55,6 +69,9 @@ class ESPRangeView : public ESPColorSettable {
  protected:
   friend ESPRangeIterator;
 
+  /// Replace every LED by `transform(led)`.
+  template<typename F> void transform_(F &&transform);
+
   AddressableLight *parent_;
   int32_t begin_;
   int32_t end_;
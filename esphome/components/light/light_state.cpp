@@ -100,6 +100,16 @@ void LightState::dump_config() {
   }
 }
 void LightState::loop() {
+  this->render_();
+
+  // Write state to the light
+  if (this->next_write_) {
+    this->next_write_ = false;
+    this->output_->write_state(this);
+  }
+}
+
+void LightState::render_() {
   // Apply effect (if any)
   auto *effect = this->get_active_effect_();
   if (effect != nullptr) {
@@ -126,12 +136,6 @@ void LightState::loop() {
       this->target_state_reached_callback_.call();
     }
   }
-
-  // Write state to the light
-  if (this->next_write_) {
-    this->next_write_ = false;
-    this->output_->write_state(this);
-  }
 }
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
@@ -147,10 +151,10 @@ std::string LightState::get_effect_name() {
   }
 }
 
-void LightState::add_new_remote_values_callback(std::function<void()> &&send_callback) {
+void LightState::add_new_remote_values_callback(InlineFunction<void()> &&send_callback) {
   this->remote_values_callback_.add(std::move(send_callback));
 }
-void LightState::add_new_target_state_reached_callback(std::function<void()> &&send_callback) {
+void LightState::add_new_target_state_reached_callback(InlineFunction<void()> &&send_callback) {
   this->target_state_reached_callback_.add(std::move(send_callback));
 }
 
@@ -120,7 +120,7 @@ class LightState : public EntityBase, public Component {
    *
    * @param send_callback The callback.
    */
-  void add_new_remote_values_callback(std::function<void()> &&send_callback);
+  void add_new_remote_values_callback(InlineFunction<void()> &&send_callback);
 
   /**
    * The callback is called once the state of current_values and remote_values are equal (when the
@@ -128,7 +128,7 @@ class LightState : public EntityBase, public Component {
    *
    * @param send_callback
    */
-  void add_new_target_state_reached_callback(std::function<void()> &&send_callback);
+  void add_new_target_state_reached_callback(InlineFunction<void()> &&send_callback);
 
   /// Set the default transition length, i.e. the transition length when no transition is provided.
   void set_default_transition_length(uint32_t default_transition_length);
@@ -192,6 +192,9 @@ class LightState : public EntityBase, public Component {
   friend LightCall;
   friend class AddressableLight;
 
+  /// Apply the active effect and transformer (if any), which set next_write_ when the output has to be written.
+  void render_();
+
   /// Internal method to start an effect with the given index
   void start_effect_(uint32_t effect_index);
   /// Internal method to get the currently active effect
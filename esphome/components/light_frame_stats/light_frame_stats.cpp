@@ -0,0 +1,38 @@
+#include "light_frame_stats.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace light_frame_stats {
+
+static const char *const TAG = "light_frame_stats";
+
+void LightFrameStats::update() {
+  const auto &stats = this->light_->get_frame_stats();
+  const uint32_t elapsed = millis() - stats.start;
+
+  if (this->fps_sensor_ != nullptr && elapsed != 0)
+    this->fps_sensor_->publish_state(stats.writes * 1000.0f / elapsed);
+  if (this->render_time_sensor_ != nullptr)
+    this->render_time_sensor_->publish_state(stats.frames == 0 ? NAN : stats.render_time / 1000.0f / stats.frames);
+  if (this->output_time_sensor_ != nullptr)
+    this->output_time_sensor_->publish_state(stats.writes == 0 ? NAN : stats.output_time / 1000.0f / stats.writes);
+  if (this->dropped_frames_sensor_ != nullptr)
+    this->dropped_frames_sensor_->publish_state(stats.dropped);
+
+  this->light_->reset_frame_stats();
+}
+
+void LightFrameStats::dump_config() {
+  ESP_LOGCONFIG(TAG, "Light Frame Stats '%s':", this->light_->get_name().c_str());
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "FPS", this->fps_sensor_);
+  LOG_SENSOR("  ", "Render Time", this->render_time_sensor_);
+  LOG_SENSOR("  ", "Output Time", this->output_time_sensor_);
+  LOG_SENSOR("  ", "Dropped Frames", this->dropped_frames_sensor_);
+}
+
+}  // namespace light_frame_stats
+}  // namespace esphome
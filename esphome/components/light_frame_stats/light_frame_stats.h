@@ -0,0 +1,35 @@
+#pragma once
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace light_frame_stats {
+
+/// Publishes the frame timing of an addressable light, over the time since the previous update.
+class LightFrameStats : public PollingComponent {
+ public:
+  explicit LightFrameStats(light::AddressableLightState *light) : light_(light) {}
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_fps_sensor(sensor::Sensor *fps_sensor) { this->fps_sensor_ = fps_sensor; }
+  void set_render_time_sensor(sensor::Sensor *render_time_sensor) { this->render_time_sensor_ = render_time_sensor; }
+  void set_output_time_sensor(sensor::Sensor *output_time_sensor) { this->output_time_sensor_ = output_time_sensor; }
+  void set_dropped_frames_sensor(sensor::Sensor *dropped_frames_sensor) {
+    this->dropped_frames_sensor_ = dropped_frames_sensor;
+  }
+
+ protected:
+  light::AddressableLightState *light_;
+  sensor::Sensor *fps_sensor_{nullptr};             ///< Frames written per second
+  sensor::Sensor *render_time_sensor_{nullptr};     ///< Average time of effects and transitions per frame
+  sensor::Sensor *output_time_sensor_{nullptr};     ///< Average time of writing a frame to the output
+  sensor::Sensor *dropped_frames_sensor_{nullptr};  ///< Frames skipped since the previous update
+};
+
+}  // namespace light_frame_stats
+}  // namespace esphome
@@ -0,0 +1,76 @@
+import esphome.codegen as cg
+from esphome.components import light, sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    CONF_ID,
+    CONF_LIGHT_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_HERTZ,
+    UNIT_MILLISECOND,
+)
+
+DEPENDENCIES = ["light"]
+
+CONF_FPS = "fps"
+CONF_RENDER_TIME = "render_time"
+CONF_OUTPUT_TIME = "output_time"
+CONF_DROPPED_FRAMES = "dropped_frames"
+
+light_frame_stats_ns = cg.esphome_ns.namespace("light_frame_stats")
+LightFrameStats = light_frame_stats_ns.class_("LightFrameStats", cg.PollingComponent)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LightFrameStats),
+        cv.GenerateID(CONF_LIGHT_ID): cv.use_id(light.AddressableLightState),
+        cv.Optional(CONF_FPS): sensor.sensor_schema(
+            unit_of_measurement=UNIT_HERTZ,
+            icon=ICON_COUNTER,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_RENDER_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_OUTPUT_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_DROPPED_FRAMES): sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    light_ = await cg.get_variable(config[CONF_LIGHT_ID])
+    var = cg.new_Pvariable(config[CONF_ID], light_)
+    await cg.register_component(var, config)
+
+    if fps_config := config.get(CONF_FPS):
+        sens = await sensor.new_sensor(fps_config)
+        cg.add(var.set_fps_sensor(sens))
+    if render_time_config := config.get(CONF_RENDER_TIME):
+        sens = await sensor.new_sensor(render_time_config)
+        cg.add(var.set_render_time_sensor(sens))
+    if output_time_config := config.get(CONF_OUTPUT_TIME):
+        sens = await sensor.new_sensor(output_time_config)
+        cg.add(var.set_output_time_sensor(sens))
+    if dropped_frames_config := config.get(CONF_DROPPED_FRAMES):
+        sens = await sensor.new_sensor(dropped_frames_config)
+        cg.add(var.set_dropped_frames_sensor(sens))
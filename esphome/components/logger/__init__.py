@@ -1,3 +1,4 @@
+from pathlib import Path
 import re
 
 from esphome import automation
@@ -15,6 +16,7 @@ from esphome.components.esp32.const import (
 )
 from esphome.components.libretiny import get_libretiny_component, get_libretiny_family
 from esphome.components.libretiny.const import COMPONENT_BK72XX, COMPONENT_RTL87XX
+from esphome.config import iter_components
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_ARGS,
@@ -32,11 +34,14 @@ from esphome.const import (
     PLATFORM_BK72XX,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
     PLATFORM_RTL87XX,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
 
+from .tokenizer import DICTIONARY_FILE, build_dictionary, write_dictionary
+
 CODEOWNERS = ["@esphome/core"]
 logger_ns = cg.esphome_ns.namespace("logger")
 LOG_LEVELS = {
@@ -164,12 +169,36 @@ def validate_local_no_higher_than_global(value):
 
 
 Logger = logger_ns.class_("Logger", cg.Component)
+LoggerSetLevelAction = logger_ns.class_(
+    "LoggerSetLevelAction", automation.Action, cg.Parented.template(Logger)
+)
 LoggerMessageTrigger = logger_ns.class_(
     "LoggerMessageTrigger",
     automation.Trigger.template(cg.int_, cg.const_char_ptr, cg.const_char_ptr),
 )
 
+CONF_ASYNC_QUEUE_SIZE = "async_queue_size"
+CONF_TOKENIZED = "tokenized"
+CONF_TOKENS_ID = "tokens_id"
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+
+
+def validate_async_queue_size(value):
+    value = cv.int_range(min=4, max=1024)(value)
+    if value & (value - 1):
+        raise cv.Invalid("The async queue size must be a power of two")
+    return value
+
+
+def validate_tokenized(config):
+    if config.get(CONF_TOKENIZED) and CONF_ASYNC_QUEUE_SIZE not in config:
+        raise cv.Invalid(
+            f"{CONF_TOKENIZED} requires {CONF_ASYNC_QUEUE_SIZE} to be set",
+            [CONF_TOKENIZED],
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -213,15 +242,31 @@ CONFIG_SCHEMA = cv.All(
                     cv.Optional(CONF_LEVEL, default="WARN"): is_log_level,
                 }
             ),
+            cv.Optional(CONF_ASYNC_QUEUE_SIZE): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_HOST]), validate_async_queue_size
+            ),
+            cv.Optional(CONF_TOKENIZED, default=False): cv.boolean,
+            cv.GenerateID(CONF_TOKENS_ID): cv.declare_id(cg.uint32),
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_tokenized,
 )
 
 
+def log_source_files() -> list[Path]:
+    """The paths of all C++ sources of the loaded components."""
+    paths = []
+    for _, component in iter_components(CORE.config):
+        for resource in component.resources:
+            with resource.path() as path:
+                paths.append(Path(path))
+    return paths
+
+
 @coroutine_with_priority(90.0)
 async def to_code(config):
     baud_rate = config[CONF_BAUD_RATE]
@@ -232,6 +277,9 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if CONF_ASYNC_QUEUE_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_queue_size(config[CONF_ASYNC_QUEUE_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -242,6 +290,17 @@ async def to_code(config):
     this_severity = LOG_LEVEL_SEVERITY.index(level)
     cg.add_build_flag(f"-DESPHOME_LOG_LEVEL={LOG_LEVELS[level]}")
 
+    if config[CONF_TOKENIZED]:
+        cg.add_define("USE_LOGGER_TOKENIZED")
+        # Log calls above the level are compiled out and need no token
+        tokens = build_dictionary(log_source_files(), this_severity)
+        dictionary = Path(CORE.relative_build_path(DICTIONARY_FILE))
+        dictionary.parent.mkdir(parents=True, exist_ok=True)
+        write_dictionary(dictionary, tokens)
+        if tokens:
+            tokens_arr = cg.static_const_array(config[CONF_TOKENS_ID], sorted(tokens))
+            cg.add(log.set_log_tokens(tokens_arr, len(tokens)))
+
     verbose_severity = LOG_LEVEL_SEVERITY.index("VERBOSE")
     very_verbose_severity = LOG_LEVEL_SEVERITY.index("VERY_VERBOSE")
     is_at_least_verbose = this_severity >= verbose_severity
@@ -365,3 +424,32 @@ async def logger_log_action_to_code(config, action_id, template_arg, args):
 
     lambda_ = await cg.process_lambda(Lambda(text), args, return_type=cg.void)
     return cg.new_Pvariable(action_id, template_arg, lambda_)
+
+
+CONF_LOGGER_SET_LEVEL = "logger.set_level"
+LOGGER_SET_LEVEL_ACTION_SCHEMA = cv.maybe_simple_value(
+    {
+        cv.GenerateID(): cv.use_id(Logger),
+        cv.Required(CONF_LEVEL): cv.templatable(is_log_level),
+        cv.Optional(CONF_TAG): cv.templatable(cv.string),
+    },
+    key=CONF_LEVEL,
+)
+
+
+@automation.register_action(
+    CONF_LOGGER_SET_LEVEL, LoggerSetLevelAction, LOGGER_SET_LEVEL_ACTION_SCHEMA
+)
+async def logger_set_level_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    level = config[CONF_LEVEL]
+    if cg.is_template(level):
+        level = await cg.templatable(level, args, cg.int_)
+    else:
+        level = LOG_LEVELS[level]
+    cg.add(var.set_level(level))
+    if CONF_TAG in config:
+        tag = await cg.templatable(config[CONF_TAG], args, cg.std_string)
+        cg.add(var.set_tag(tag))
+    return var
@@ -0,0 +1,617 @@
+#include "log_queue.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace esphome {
+namespace logger {
+
+namespace {
+
+/// How an argument is read from the va_list, and stored in a LogRecord.
+enum class ArgType : uint8_t {
+  NONE,  ///< "%%", takes no argument
+  INT,
+  LONG,
+  LONG_LONG,
+  SIZE,
+  INTMAX,
+  PTRDIFF,
+  DOUBLE,
+  LONG_DOUBLE,
+  POINTER,
+  STRING,
+  COUNT,  ///< "%n", the pointer is taken but nothing is written to it
+  INVALID,
+};
+
+struct FormatSpec {
+  const char *start;    ///< The '%' this conversion starts with
+  size_t length;        ///< Length including the conversion character
+  ArgType type;         ///< Type of the converted argument
+  char conversion;      ///< The conversion character, like 'd' or 's'
+  uint8_t stars;        ///< Number of int arguments for '*' width and precision before it
+  bool precision_star;  ///< Whether the last of these is the precision
+  int precision;        ///< Precision given in the format string, -1 if none
+};
+
+/// Parse the conversion specification starting at the '%' `p` points to, returns the first character after it.
+const char *parse_format_spec(const char *p, FormatSpec &spec) {
+  spec.start = p++;
+  spec.stars = 0;
+  spec.precision_star = false;
+  spec.precision = -1;
+
+  while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+    p++;
+  if (*p == '*') {
+    spec.stars++;
+    p++;
+  } else {
+    while (*p >= '0' && *p <= '9')
+      p++;
+  }
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      spec.stars++;
+      spec.precision_star = true;
+      p++;
+    } else {
+      spec.precision = 0;
+      while (*p >= '0' && *p <= '9')
+        spec.precision = spec.precision * 10 + (*p++ - '0');
+    }
+  }
+
+  char length = '\0';
+  if (*p == 'h') {
+    p++;
+    if (*p == 'h')
+      p++;
+  } else if (*p == 'l') {
+    length = *p++;
+    if (*p == 'l') {
+      length = 'q';
+      p++;
+    }
+  } else if (*p == 'L' || *p == 'q' || *p == 'z' || *p == 'j' || *p == 't') {
+    length = *p++;
+  }
+
+  char conversion = *p;
+  spec.conversion = conversion;
+  if (conversion == '\0') {
+    spec.type = ArgType::INVALID;
+    spec.length = p - spec.start;
+    return p;
+  }
+  p++;
+  spec.length = p - spec.start;
+
+  switch (conversion) {
+    case '%':
+      spec.type = ArgType::NONE;
+      break;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      switch (length) {
+        case 'l':
+          spec.type = ArgType::LONG;
+          break;
+        case 'q':
+        case 'L':
+          spec.type = ArgType::LONG_LONG;
+          break;
+        case 'z':
+          spec.type = ArgType::SIZE;
+          break;
+        case 'j':
+          spec.type = ArgType::INTMAX;
+          break;
+        case 't':
+          spec.type = ArgType::PTRDIFF;
+          break;
+        default:
+          spec.type = ArgType::INT;
+          break;
+      }
+      break;
+    case 'c':
+      spec.type = ArgType::INT;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.type = length == 'L' ? ArgType::LONG_DOUBLE : ArgType::DOUBLE;
+      break;
+    case 'p':
+      spec.type = ArgType::POINTER;
+      break;
+    case 's':
+      spec.type = ArgType::STRING;
+      break;
+    case 'n':
+      spec.type = ArgType::COUNT;
+      break;
+    default:
+      spec.type = ArgType::INVALID;
+      break;
+  }
+  return p;
+}
+
+/// Appends arguments to the data of a record, after the format string. Returns false if an argument doesn't fit.
+class ArgWriter {
+ public:
+  explicit ArgWriter(LogRecord &record) : record_(record) { record.args_len = 0; }
+
+  template<typename T> bool put(T value) {
+    if (this->remaining_() < sizeof(T))
+      return false;
+    memcpy(this->end_(), &value, sizeof(T));
+    this->record_.args_len += sizeof(T);
+    return true;
+  }
+
+  /// Copy at most `max_len` characters of `str`, all of them if `max_len` is negative.
+  bool put_string(const char *str, int max_len) {
+    if (str == nullptr)
+      str = "(null)";
+    size_t remaining = this->remaining_();
+    if (remaining == 0)
+      return false;
+    // Only read as far as needed to find out whether the string fits, it may not be null terminated with a precision
+    size_t limit = max_len < 0 ? remaining : std::min<size_t>(max_len, remaining);
+    size_t len = strnlen(str, limit);
+    if (len == remaining)
+      return false;
+    char *dst = reinterpret_cast<char *>(this->end_());
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+    this->record_.args_len += len + 1;
+    return true;
+  }
+
+ protected:
+  size_t remaining_() const {
+    return LogRecord::DATA_SIZE - this->record_.args_start - this->record_.args_len;
+  }
+  uint8_t *end_() { return this->record_.data + this->record_.args_start + this->record_.args_len; }
+
+  LogRecord &record_;
+};
+
+/// Reads back the arguments appended by ArgWriter.
+class ArgReader {
+ public:
+  explicit ArgReader(const LogRecord &record) : record_(record) {}
+
+  template<typename T> bool get(T &value) {
+    if (this->record_.args_len - this->at_ < sizeof(T))
+      return false;
+    memcpy(&value, this->args_() + this->at_, sizeof(T));
+    this->at_ += sizeof(T);
+    return true;
+  }
+
+  bool get_string(const char *&str) {
+    if (this->at_ >= this->record_.args_len)
+      return false;
+    str = reinterpret_cast<const char *>(this->args_() + this->at_);
+    this->at_ += strlen(str) + 1;
+    return true;
+  }
+
+ protected:
+  const uint8_t *args_() const { return this->record_.data + this->record_.args_start; }
+
+  const LogRecord &record_;
+  size_t at_{0};
+};
+
+template<typename T>
+int format_arg(char *buffer, size_t size, const char *spec, const int *stars, uint8_t star_count, T value) {
+  switch (star_count) {
+    case 0:
+      return snprintf(buffer, size, spec, value);
+    case 1:
+      return snprintf(buffer, size, spec, stars[0], value);
+    default:
+      return snprintf(buffer, size, spec, stars[0], stars[1], value);
+  }
+}
+
+/// Read the argument of one conversion and format it, returns -1 if the argument is missing.
+template<typename T>
+int format_arg(ArgReader &reader, char *buffer, size_t size, const char *spec, const int *stars, uint8_t star_count) {
+  T value;
+  if (!reader.get(value))
+    return -1;
+  return format_arg(buffer, size, spec, stars, star_count, value);
+}
+
+#ifdef USE_LOGGER_TOKENIZED
+/// Appends the fields of a tokenized message, see LogRecord::encode().
+class TokenWriter {
+ public:
+  TokenWriter(uint8_t *buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+  bool put_byte(uint8_t value) {
+    if (this->at_ >= this->size_)
+      return false;
+    this->buffer_[this->at_++] = value;
+    return true;
+  }
+  bool put_varint(uint64_t value) {
+    while (value >= 0x80) {
+      if (!this->put_byte(static_cast<uint8_t>(value | 0x80)))
+        return false;
+      value >>= 7;
+    }
+    return this->put_byte(static_cast<uint8_t>(value));
+  }
+  bool put_signed(int64_t value) {
+    return this->put_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+  bool put_bytes(const void *data, size_t len) {
+    if (this->size_ - this->at_ < len)
+      return false;
+    memcpy(this->buffer_ + this->at_, data, len);
+    this->at_ += len;
+    return true;
+  }
+  size_t size() const { return this->at_; }
+  /// Drop everything written after `size`.
+  void truncate(size_t size) { this->at_ = size; }
+
+ protected:
+  uint8_t *buffer_;
+  size_t size_;
+  size_t at_{0};
+};
+
+/// Read an integer argument of type T and write it as a varint, signed for %d and %i.
+template<typename T> bool encode_integer(ArgReader &reader, TokenWriter &writer, char conversion) {
+  T value;
+  if (!reader.get(value))
+    return false;
+  if (conversion == 'd' || conversion == 'i')
+    return writer.put_signed(static_cast<int64_t>(value));
+  return writer.put_varint(static_cast<typename std::make_unsigned<T>::type>(value));
+}
+
+template<typename T> bool encode_float(ArgReader &reader, TokenWriter &writer) {
+  T value;
+  if (!reader.get(value))
+    return false;
+  auto converted = static_cast<double>(value);
+  uint8_t bytes[sizeof(double)];
+  memcpy(bytes, &converted, sizeof(double));
+  return writer.put_bytes(bytes, sizeof(double));
+}
+
+/// Encode the value of one conversion, with its '*' width and precision.
+bool encode_value(const FormatSpec &spec, ArgReader &reader, TokenWriter &writer) {
+  for (uint8_t i = 0; i < spec.stars; i++) {
+    int star;
+    if (!reader.get(star) || !writer.put_signed(star))
+      return false;
+  }
+  switch (spec.type) {
+    case ArgType::INT:
+      return encode_integer<int>(reader, writer, spec.conversion);
+    case ArgType::LONG:
+      return encode_integer<long>(reader, writer, spec.conversion);
+    case ArgType::LONG_LONG:
+      return encode_integer<long long>(reader, writer, spec.conversion);
+    case ArgType::SIZE:
+      return encode_integer<size_t>(reader, writer, spec.conversion);
+    case ArgType::INTMAX:
+      return encode_integer<intmax_t>(reader, writer, spec.conversion);
+    case ArgType::PTRDIFF:
+      return encode_integer<ptrdiff_t>(reader, writer, spec.conversion);
+    case ArgType::DOUBLE:
+      return encode_float<double>(reader, writer);
+    case ArgType::LONG_DOUBLE:
+      return encode_float<long double>(reader, writer);
+    case ArgType::POINTER: {
+      void *value;
+      return reader.get(value) && writer.put_varint(reinterpret_cast<uintptr_t>(value));
+    }
+    case ArgType::STRING: {
+      const char *str;
+      if (!reader.get_string(str))
+        return false;
+      size_t len = strlen(str);
+      return writer.put_varint(len) && writer.put_bytes(str, len);
+    }
+    default:
+      // "%%" and "%n" take no value
+      return true;
+  }
+}
+#endif
+
+/// Copy the arguments of the format string in `record` from `args`, returns false if they don't fit.
+bool pack_args(LogRecord &record, va_list args) {
+  ArgWriter writer(record);
+  for (const char *p = record.format(); *p != '\0';) {
+    if (*p != '%') {
+      p++;
+      continue;
+    }
+    FormatSpec spec;
+    p = parse_format_spec(p, spec);
+    int precision = spec.precision;
+    for (uint8_t i = 0; i < spec.stars; i++) {
+      int value = va_arg(args, int);
+      if (spec.precision_star && i + 1 == spec.stars)
+        precision = value;
+      if (!writer.put(value))
+        return false;
+    }
+
+    bool ok = true;
+    switch (spec.type) {
+      case ArgType::NONE:
+        break;
+      case ArgType::INT:
+        ok = writer.put(va_arg(args, int));
+        break;
+      case ArgType::LONG:
+        ok = writer.put(va_arg(args, long));
+        break;
+      case ArgType::LONG_LONG:
+        ok = writer.put(va_arg(args, long long));
+        break;
+      case ArgType::SIZE:
+        ok = writer.put(va_arg(args, size_t));
+        break;
+      case ArgType::INTMAX:
+        ok = writer.put(va_arg(args, intmax_t));
+        break;
+      case ArgType::PTRDIFF:
+        ok = writer.put(va_arg(args, ptrdiff_t));
+        break;
+      case ArgType::DOUBLE:
+        ok = writer.put(va_arg(args, double));
+        break;
+      case ArgType::LONG_DOUBLE:
+        ok = writer.put(va_arg(args, long double));
+        break;
+      case ArgType::POINTER:
+        ok = writer.put(va_arg(args, void *));
+        break;
+      case ArgType::STRING:
+        ok = writer.put_string(va_arg(args, const char *), precision);
+        break;
+      case ArgType::COUNT:
+        va_arg(args, int *);
+        break;
+      case ArgType::INVALID:
+        // Formatting stops here
+        return true;
+    }
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void LogRecord::pack(const char *tag, const char *format, va_list args) {
+  size_t tag_len = strnlen(tag, TAG_SIZE - 1);
+  memcpy(this->tag, tag, tag_len);
+  this->tag[tag_len] = '\0';
+
+  size_t format_size = strlen(format) + 1;
+  if (format_size <= DATA_SIZE) {
+    memcpy(this->data, format, format_size);
+    this->formatted = false;
+    this->args_start = format_size;
+    va_list copy;
+    va_copy(copy, args);
+    bool packed = pack_args(*this, copy);
+    va_end(copy);
+    if (packed)
+      return;
+  }
+
+  // Too long to format later, so format now and cut what still doesn't fit
+  this->formatted = true;
+  this->args_start = 0;
+  this->args_len = 0;
+  int len = vsnprintf(reinterpret_cast<char *>(this->data), DATA_SIZE, format, args);
+  if (len >= static_cast<int>(DATA_SIZE)) {
+    size_t marker_len = strlen(TRUNCATED_MARKER);
+    memcpy(this->data + DATA_SIZE - 1 - marker_len, TRUNCATED_MARKER, marker_len);
+  }
+}
+
+size_t LogRecord::format_message(char *buffer, size_t size) const {
+  if (size == 0)
+    return 0;
+  if (this->formatted) {
+    size_t len = strnlen(reinterpret_cast<const char *>(this->data), size - 1);
+    memcpy(buffer, this->data, len);
+    buffer[len] = '\0';
+    return len;
+  }
+  ArgReader reader(*this);
+  char spec_buffer[24];
+  size_t at = 0;
+  for (const char *p = this->format(); *p != '\0' && at + 1 < size;) {
+    if (*p != '%') {
+      buffer[at++] = *p++;
+      continue;
+    }
+    FormatSpec spec;
+    p = parse_format_spec(p, spec);
+    if (spec.type == ArgType::INVALID || spec.length >= sizeof(spec_buffer))
+      break;
+    if (spec.type == ArgType::NONE) {
+      buffer[at++] = '%';
+      continue;
+    }
+    int stars[2];
+    bool missing = false;
+    for (uint8_t i = 0; i < spec.stars; i++)
+      missing |= !reader.get(stars[i]);
+    if (missing)
+      break;
+    memcpy(spec_buffer, spec.start, spec.length);
+    spec_buffer[spec.length] = '\0';
+
+    char *dst = buffer + at;
+    size_t remaining = size - at;
+    int ret;
+    switch (spec.type) {
+      case ArgType::INT:
+        ret = format_arg<int>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::LONG:
+        ret = format_arg<long>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::LONG_LONG:
+        ret = format_arg<long long>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::SIZE:
+        ret = format_arg<size_t>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::INTMAX:
+        ret = format_arg<intmax_t>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::PTRDIFF:
+        ret = format_arg<ptrdiff_t>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::DOUBLE:
+        ret = format_arg<double>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::LONG_DOUBLE:
+        ret = format_arg<long double>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::POINTER:
+        ret = format_arg<void *>(reader, dst, remaining, spec_buffer, stars, spec.stars);
+        break;
+      case ArgType::STRING: {
+        const char *str;
+        ret = reader.get_string(str) ? format_arg(dst, remaining, spec_buffer, stars, spec.stars, str) : -1;
+        break;
+      }
+      default:
+        // "%n"
+        ret = 0;
+        break;
+    }
+    if (ret < 0)
+      break;
+    at += std::min<size_t>(ret, remaining - 1);
+  }
+  buffer[at] = '\0';
+  return at;
+}
+
+#ifdef USE_LOGGER_TOKENIZED
+uint32_t LogRecord::get_token() const {
+  uint32_t hash = 2166136261UL;
+  for (const char *c = this->tag; *c != '\0'; c++)
+    hash = (hash * 16777619UL) ^ static_cast<uint8_t>(*c);
+  hash *= 16777619UL;  // the null terminator separating tag and format
+  for (const char *c = this->format(); *c != '\0'; c++)
+    hash = (hash * 16777619UL) ^ static_cast<uint8_t>(*c);
+  return hash;
+}
+
+size_t LogRecord::encode(uint32_t token, uint8_t *buffer, size_t size) const {
+  TokenWriter writer(buffer, size);
+  size_t name_len = strlen(this->task_name);
+  bool ok = writer.put_byte(TOKENIZED_MARKER) && writer.put_byte(this->level) && writer.put_varint(this->line) &&
+            writer.put_bytes(&token, sizeof(token)) && writer.put_byte(name_len) &&
+            writer.put_bytes(this->task_name, name_len);
+  if (!ok)
+    return 0;
+
+  ArgReader reader(*this);
+  for (const char *p = this->format(); *p != '\0' && ok;) {
+    if (*p != '%') {
+      p++;
+      continue;
+    }
+    FormatSpec spec;
+    p = parse_format_spec(p, spec);
+    if (spec.type == ArgType::INVALID)
+      break;
+    // A value that doesn't fit is left out completely
+    size_t complete = writer.size();
+    ok = encode_value(spec, reader, writer);
+    if (!ok)
+      writer.truncate(complete);
+  }
+  if (!ok)
+    buffer[1] |= TOKENIZED_TRUNCATED;
+  return writer.size();
+}
+#endif
+
+LogQueue::LogQueue(size_t capacity) : slots_(new Slot[capacity]), mask_(capacity - 1) {
+  for (uint32_t i = 0; i < capacity; i++)
+    this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+LogRecord *LogQueue::acquire(uint32_t &ticket) {
+  uint32_t pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Slot &slot = this->slots_[pos & this->mask_];
+    auto diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      // The slot is free, try to claim it before another producer does
+      if (this->enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        ticket = pos;
+        return &slot.record;
+      }
+    } else if (diff < 0) {
+      // The consumer has not released the record from the previous round yet
+      return nullptr;
+    } else {
+      // Another producer claimed the slot first
+      pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void LogQueue::commit(uint32_t ticket) {
+  this->slots_[ticket & this->mask_].sequence.store(ticket + 1, std::memory_order_release);
+}
+
+LogRecord *LogQueue::front() {
+  Slot &slot = this->slots_[this->dequeue_pos_ & this->mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != this->dequeue_pos_ + 1)
+    return nullptr;
+  return &slot.record;
+}
+
+void LogQueue::pop() {
+  Slot &slot = this->slots_[this->dequeue_pos_ & this->mask_];
+  slot.sequence.store(this->dequeue_pos_ + this->mask_ + 1, std::memory_order_release);
+  this->dequeue_pos_++;
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
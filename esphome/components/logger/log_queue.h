@@ -0,0 +1,109 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** A log call with its formatting deferred.
+ *
+ * The tag, the format string and the arguments, including the strings passed for %s, are copied into the record, so
+ * all of them may be temporaries like the c_str() of a std::string. If the format string and arguments don't fit into
+ * `data`, the message is formatted right away instead, and cut with TRUNCATED_MARKER if it is still too long.
+ */
+struct LogRecord {
+  static constexpr size_t DATA_SIZE = 160;
+  static constexpr size_t TAG_SIZE = 32;  ///< Fits the longest tags, like "esp32_ble_server.characteristic"
+  static constexpr size_t TASK_NAME_SIZE = 16;
+  /// Ends a message that was cut to fit into the record.
+  static constexpr const char *TRUNCATED_MARKER = "...";
+
+  /// Store the log call of `tag`, `format` and `args`.
+  void pack(const char *tag, const char *format, va_list args);
+  /** Format the message into `buffer`, like vsnprintf() would have with the original arguments.
+   *
+   * @return The number of characters written, excluding the null terminator, at most `size - 1`.
+   */
+  size_t format_message(char *buffer, size_t size) const;
+  /// The format string, only if the message hasn't been formatted yet.
+  const char *format() const { return reinterpret_cast<const char *>(this->data); }
+
+#ifdef USE_LOGGER_TOKENIZED
+  /// First byte of a tokenized message, which never starts a text message.
+  static constexpr uint8_t TOKENIZED_MARKER = 0x00;
+  /// Set in the level byte of a tokenized message when not all arguments are included.
+  static constexpr uint8_t TOKENIZED_TRUNCATED = 0x80;
+
+  /// The token identifying the tag and format string of this record: the 32-bit FNV-1 hash of both, with the null
+  /// terminator of the tag in between. Only for records that haven't been formatted.
+  uint32_t get_token() const;
+  /** Encode the record as a tokenized message instead of formatting it.
+   *
+   * The message consists of the marker, the level, the line as a varint, the token (4 bytes, little endian), the task
+   * name (length byte and characters) and then the value of every conversion of the format string: integers as varints
+   * (zigzag encoded for %d and %i), floating point numbers as 8 byte doubles and strings as varint length and
+   * characters. '*' widths and precisions come before their value as signed varints.
+   *
+   * @return The length of the message, which is cut at `size` with the truncated flag set.
+   */
+  size_t encode(uint32_t token, uint8_t *buffer, size_t size) const;
+#endif
+
+  char tag[TAG_SIZE];
+  uint16_t line;
+  uint8_t level;
+  bool formatted;                  ///< `data` holds the formatted message instead of the format string and arguments
+  uint8_t args_start;              ///< Offset of the arguments in `data`, after the format string
+  uint8_t args_len;                ///< Bytes of arguments in `data`
+  char task_name[TASK_NAME_SIZE];  ///< Name of the task that logged, empty for the main task
+  uint8_t data[DATA_SIZE];         ///< The format string followed by the arguments, or the formatted message
+};
+
+/** Bounded lock-free queue of log records with multiple producers and a single consumer.
+ *
+ * Producers claim a slot with acquire(), fill the record in place and publish it with commit(). Claiming is a single
+ * compare-and-swap, so any task can log without taking a lock, and a full queue makes acquire() fail instead of
+ * blocking. The consumer takes the records in the order they were claimed with front() and pop().
+ */
+class LogQueue {
+ public:
+  /// Create a queue for `capacity` records, which must be a power of two.
+  explicit LogQueue(size_t capacity);
+
+  /// Claim the next free record, nullptr if the queue is full. `ticket` must be passed to commit() afterwards.
+  LogRecord *acquire(uint32_t &ticket);
+  /// Make a record claimed by acquire() available to the consumer.
+  void commit(uint32_t ticket);
+
+  /// The oldest record, nullptr if there is none or it has not been committed yet. Consumer only.
+  LogRecord *front();
+  /// Release the record returned by front(). Consumer only.
+  void pop();
+
+  size_t capacity() const { return this->mask_ + 1; }
+
+ protected:
+  struct Slot {
+    /// Equal to the position of the slot when free, one more when committed.
+    std::atomic<uint32_t> sequence;
+    LogRecord record;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  uint32_t mask_;
+  std::atomic<uint32_t> enqueue_pos_{0};
+  uint32_t dequeue_pos_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
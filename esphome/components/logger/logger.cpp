@@ -1,5 +1,7 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -31,7 +33,7 @@ static const char *const LOG_LEVEL_LETTERS[] = {
     "VV",  // VERY_VERBOSE
 };
 
-void Logger::write_header_(int level, const char *tag, int line) {
+void Logger::write_header_(int level, const char *tag, int line, const char *thread_name) {
   if (level < 0)
     level = 0;
   if (level > 7)
@@ -39,41 +41,205 @@ void Logger::write_header_(int level, const char *tag, int line) {
 
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
+  if (thread_name == nullptr) {
+    this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
+  } else {
+    this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
+                            ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
+  }
+}
+
+const char *Logger::get_thread_name_() {
 #if defined(USE_ESP32) || defined(USE_LIBRETINY)
   TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
 #else
   void *current_task = nullptr;
 #endif
-  if (current_task == main_task_) {
-    this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
-  } else {
-    const char *thread_name = "";
+  if (current_task == main_task_)
+    return nullptr;
 #if defined(USE_ESP32)
-    thread_name = pcTaskGetName(current_task);
+  return pcTaskGetName(current_task);
 #elif defined(USE_LIBRETINY)
-    thread_name = pcTaskGetTaskName(current_task);
+  return pcTaskGetTaskName(current_task);
+#else
+  return "";
 #endif
-    this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
-                            ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
-  }
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->max_level_ || level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_ASYNC
+  if (this->queue_ != nullptr) {
+    this->log_async_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
   this->reset_buffer_();
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, this->get_thread_name_());
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
   this->log_message_(level, tag);
   recursion_guard_ = false;
 }
+
+#ifdef USE_LOGGER_ASYNC
+void HOT Logger::log_async_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  const char *thread_name = this->get_thread_name_();
+  if (thread_name == nullptr) {
+    if (this->recursion_guard_)
+      return;
+    if (!this->defer_main_task_) {
+      // Before the first loop(), show messages of the main task right away, so that they are not lost on a crash
+      this->process_queue_();
+      this->recursion_guard_ = true;
+      this->reset_buffer_();
+      this->write_header_(level, tag, line, nullptr);
+      this->vprintf_to_buffer_(format, args);
+      this->write_footer_();
+      this->log_message_(level, tag);
+      this->recursion_guard_ = false;
+      return;
+    }
+  }
+
+  uint32_t ticket;
+  LogRecord *record = this->queue_->acquire(ticket);
+  if (record == nullptr && thread_name == nullptr) {
+    // The main task is the one emptying the queue, so it can make room itself
+    this->process_queue_();
+    record = this->queue_->acquire(ticket);
+  }
+  if (record == nullptr) {
+    this->dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  record->line = line;
+  record->level = level;
+  if (thread_name == nullptr) {
+    record->task_name[0] = '\0';
+  } else {
+    strncpy(record->task_name, thread_name, LogRecord::TASK_NAME_SIZE - 1);
+    record->task_name[LogRecord::TASK_NAME_SIZE - 1] = '\0';
+  }
+  record->pack(tag, format, args);
+  this->queue_->commit(ticket);
+#ifdef USE_TICKLESS_LOOP
+  App.wake_loop_any_context();
+#endif
+}
+
+void Logger::process_queue_() {
+  this->recursion_guard_ = true;
+  // Messages logged by other tasks while processing wait for the next call, so this always ends
+  for (size_t i = 0; i < this->queue_->capacity(); i++) {
+    LogRecord *record = this->queue_->front();
+    if (record == nullptr)
+      break;
+#ifdef USE_LOGGER_TOKENIZED
+    uint32_t token = record->formatted ? 0 : record->get_token();
+    if (!record->formatted && this->is_tokenized_(token)) {
+      this->log_tokenized_(*record, token);
+      this->queue_->pop();
+      continue;
+    }
+#endif
+    this->format_record_(*record);
+    this->log_message_(record->level, record->tag);
+    this->queue_->pop();
+  }
+
+  uint32_t dropped = this->dropped_messages_.exchange(0, std::memory_order_relaxed);
+  if (dropped != 0) {
+    this->dropped_total_ += dropped;
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__, nullptr);
+    this->printf_to_buffer_("Dropped %" PRIu32 " log messages, the queue was full", dropped);
+    this->write_footer_();
+    this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+  }
+  this->recursion_guard_ = false;
+}
+
+void Logger::format_record_(const LogRecord &record) {
+  this->reset_buffer_();
+  this->write_header_(record.level, record.tag, record.line, record.task_name[0] == '\0' ? nullptr : record.task_name);
+  if (!this->is_buffer_full_()) {
+    this->tx_buffer_at_ +=
+        record.format_message(this->tx_buffer_ + this->tx_buffer_at_, this->buffer_remaining_capacity_());
+  }
+  this->write_footer_();
+}
+
+void Logger::set_async_queue_size(size_t size) { this->queue_ = make_unique<LogQueue>(size); }
+#endif
+
+#ifdef USE_LOGGER_TOKENIZED
+/// Starts the serial lines of tokenized messages, followed by the message in base64.
+static const char TOKENIZED_LINE_PREFIX[] = "\x1eT";
+
+bool Logger::is_tokenized_(uint32_t token) const {
+  return std::binary_search(this->log_tokens_, this->log_tokens_ + this->log_tokens_count_, token);
+}
+
+void Logger::log_tokenized_(const LogRecord &record, uint32_t token) {
+  // The serial line has to fit into the buffer, at 4 characters per 3 bytes
+  size_t max_len = (this->tx_buffer_size_ - sizeof(TOKENIZED_LINE_PREFIX) + 1) / 4 * 3;
+  size_t len = record.encode(token, this->tokenized_buffer_, std::min(max_len, TOKENIZED_BUFFER_SIZE));
+  if (len == 0)
+    return;
+
+  if (this->baud_rate_ > 0) {
+    this->reset_buffer_();
+    this->write_to_buffer_(TOKENIZED_LINE_PREFIX, sizeof(TOKENIZED_LINE_PREFIX) - 1);
+    this->write_base64_(this->tokenized_buffer_, len);
+    this->set_null_terminator_();
+    this->write_msg_(this->tx_buffer_);
+  }
+
+#ifdef USE_ESP32
+  // See log_message_()
+  if (xPortGetFreeHeapSize() < 2048)
+    return;
+#endif
+
+  // Consumers that only take text still get the formatted message, as do those that ask for it
+  bool text_needed = this->log_callback_.size() != 0;
+  this->log_tokens_callback_.call(record.level, this->tokenized_buffer_, len, &text_needed);
+  if (text_needed) {
+    this->format_record_(record);
+    if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n')
+      this->tx_buffer_at_--;
+    this->set_null_terminator_();
+    this->log_callback_.call(record.level, record.tag, this->tx_buffer_);
+    this->log_fallback_callback_.call(record.level, record.tag, this->tx_buffer_, true);
+  }
+}
+
+void Logger::write_base64_(const uint8_t *data, size_t len) {
+  static const char *const CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (size_t i = 0; i < len; i += 3) {
+    uint32_t group = data[i] << 16;
+    if (i + 1 < len)
+      group |= data[i + 1] << 8;
+    if (i + 2 < len)
+      group |= data[i + 2];
+    this->write_to_buffer_(CHARS[(group >> 18) & 0x3F]);
+    this->write_to_buffer_(CHARS[(group >> 12) & 0x3F]);
+    this->write_to_buffer_(i + 1 < len ? CHARS[(group >> 6) & 0x3F] : '=');
+    this->write_to_buffer_(i + 2 < len ? CHARS[group & 0x3F] : '=');
+  }
+}
+#endif
+
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->max_level_ || level > this->level_for(tag) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -93,7 +259,7 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   uint32_t offset = this->tx_buffer_at_;
 
   // now apply vsnprintf
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, this->get_thread_name_());
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
   this->log_message_(level, tag, offset);
@@ -101,16 +267,106 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+// FNV-1 like fnv1_hash(), but without building a std::string for the tag
+static uint32_t tag_hash(const char *tag) {
+  uint32_t hash = 2166136261UL;
+  for (; *tag != '\0'; tag++) {
+    hash *= 16777619UL;
+    hash ^= *tag;
+  }
+  return hash;
+}
+
+static uint32_t tag_level_bit(uint32_t hash) { return 1UL << (hash >> 27); }
+
+static size_t tag_cache_index(const char *tag, uint8_t bits) {
+  // Fibonacci hashing of the pointer, the tags are (almost) always string literals with a fixed address
+  auto value = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tag));
+  return (value * 2654435761UL) >> (32 - bits);
+}
+
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
-      return it.level;
+  if (this->tag_levels_.load(std::memory_order_acquire) == nullptr)
+    return this->current_level_;
+
+  uint32_t sequence = this->tag_cache_sequence_.load(std::memory_order_acquire);
+  size_t index = tag_cache_index(tag, TAG_CACHE_BITS);
+  for (size_t i = 0; i < TAG_CACHE_PROBES; i++) {
+    TagCacheEntry &entry = this->tag_cache_[(index + i) & (TAG_CACHE_SIZE - 1)];
+    const char *cached = entry.tag.load(std::memory_order_relaxed);
+    if (cached == nullptr)
+      break;
+    if (cached == tag) {
+      uint8_t level = entry.level.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if ((sequence & 1) != 0 || this->tag_cache_sequence_.load(std::memory_order_relaxed) != sequence)
+        break;
+      return level == TAG_DEFAULT_LEVEL ? this->current_level_ : level;
     }
   }
-  return ESPHOME_LOG_LEVEL;
+  return this->resolve_level_for_(tag);
+}
+
+bool Logger::is_main_task_() const {
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  return xTaskGetCurrentTaskHandle() == this->main_task_;
+#else
+  return true;
+#endif
+}
+
+int Logger::resolve_level_for_(const char *tag) {
+  uint8_t level = TAG_DEFAULT_LEVEL;
+  uint32_t hash = tag_hash(tag);
+  if ((this->tag_level_mask_.load(std::memory_order_relaxed) & tag_level_bit(hash)) != 0) {
+    for (TagLevel *it = this->tag_levels_.load(std::memory_order_acquire); it != nullptr;
+         it = it->next.load(std::memory_order_acquire)) {
+      if (it->hash == hash && it->tag == tag) {
+        level = it->level.load(std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+  if (!this->is_main_task_())
+    return level == TAG_DEFAULT_LEVEL ? this->current_level_ : level;
+
+  size_t index = tag_cache_index(tag, TAG_CACHE_BITS);
+  TagCacheEntry *free_entry = nullptr;
+  for (size_t i = 0; i < TAG_CACHE_PROBES; i++) {
+    TagCacheEntry &entry = this->tag_cache_[(index + i) & (TAG_CACHE_SIZE - 1)];
+    if (entry.tag.load(std::memory_order_relaxed) == nullptr) {
+      free_entry = &entry;
+      break;
+    }
+  }
+  if (free_entry == nullptr) {
+    // Rather than keep the tags that took these entries forever, which may be gone or rarely logged, start over
+    this->clear_tag_cache_();
+    free_entry = &this->tag_cache_[index];
+  }
+  uint32_t sequence = this->tag_cache_sequence_.load(std::memory_order_relaxed);
+  this->tag_cache_sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  free_entry->level.store(level, std::memory_order_relaxed);
+  free_entry->tag.store(tag, std::memory_order_relaxed);
+  this->tag_cache_sequence_.store(sequence + 2, std::memory_order_release);
+  return level == TAG_DEFAULT_LEVEL ? this->current_level_ : level;
+}
+
+void Logger::clear_tag_cache_() {
+  uint32_t sequence = this->tag_cache_sequence_.load(std::memory_order_relaxed);
+  this->tag_cache_sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < TAG_CACHE_SIZE; i++)
+    this->tag_cache_[i].tag.store(nullptr, std::memory_order_relaxed);
+  this->tag_cache_sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void Logger::update_max_level_() {
+  int max_level = this->current_level_;
+  for (TagLevel *it = this->tag_levels_.load(); it != nullptr; it = it->next.load())
+    max_level = std::max<int>(max_level, it->level.load());
+  this->max_level_ = max_level;
 }
 
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
@@ -138,6 +394,9 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 #endif
 
   this->log_callback_.call(level, tag, msg);
+#ifdef USE_LOGGER_TOKENIZED
+  this->log_fallback_callback_.call(level, tag, msg, false);
+#endif
 }
 
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
@@ -148,9 +407,20 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_ASYNC
+  if (this->queue_ != nullptr) {
+    this->defer_main_task_ = true;
+    this->process_queue_();
+    // Queueing a message wakes the loop
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
+    if (this->uart_ != UART_SELECTION_USB_CDC)
+#endif
+      this->report_loop_idle();
+  }
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -168,7 +438,31 @@ void Logger::loop() {
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  std::atomic<TagLevel *> *next = &this->tag_levels_;
+  TagLevel *it;
+  while ((it = next->load()) != nullptr && it->tag != tag)
+    next = &it->next;
+  if (it != nullptr) {
+    it->level.store(log_level);
+  } else {
+    if (this->tag_cache_ == nullptr)
+      this->tag_cache_ = new TagCacheEntry[TAG_CACHE_SIZE];  // NOLINT(cppcoreguidelines-owning-memory)
+    it = new TagLevel();  // NOLINT(cppcoreguidelines-owning-memory)
+    it->tag = tag;
+    it->hash = tag_hash(tag.c_str());
+    it->level.store(log_level);
+    it->next.store(nullptr);
+    this->tag_level_mask_.fetch_or(tag_level_bit(it->hash));
+    // Other tasks can see the tag from here on
+    next->store(it, std::memory_order_release);
+  }
+  this->clear_tag_cache_();
+  this->update_max_level_();
+}
+void Logger::set_log_level(int log_level) {
+  // Messages above the compiled level are removed by the ESP_LOGx macros
+  this->current_level_ = std::min(log_level, ESPHOME_LOG_LEVEL);
+  this->update_max_level_();
 }
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
@@ -178,20 +472,36 @@ UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
 }
+#ifdef USE_LOGGER_TOKENIZED
+void Logger::add_on_log_callback(std::function<void(int, const char *, const char *, bool)> &&callback,
+                                 std::function<void(int, const uint8_t *, size_t, bool *)> &&tokens_callback) {
+  this->log_fallback_callback_.add(std::move(callback));
+  this->log_tokens_callback_.add(std::move(tokens_callback));
+}
+#endif
 float Logger::get_setup_priority() const { return setup_priority::BUS + 500.0f; }
 const char *const LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DEBUG", "VERBOSE", "VERY_VERBOSE"};
 
 void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
-  ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
+  ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[this->current_level_]);
 #ifndef USE_HOST
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", get_uart_selection_());
 #endif
 
-  for (auto &it : this->log_levels_) {
-    ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
+  for (TagLevel *it = this->tag_levels_.load(); it != nullptr; it = it->next.load()) {
+    ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it->tag.c_str(), LOG_LEVELS[it->level.load()]);
   }
+#ifdef USE_LOGGER_ASYNC
+  if (this->queue_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Queue: %zu messages (%zu bytes)", this->queue_->capacity(),
+                  this->queue_->capacity() * sizeof(LogRecord));
+  }
+#endif
+#ifdef USE_LOGGER_TOKENIZED
+  ESP_LOGCONFIG(TAG, "  Tokenized: %zu log calls", this->log_tokens_count_);
+#endif
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <cstdarg>
+#include <memory>
 #include <vector>
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_LOGGER_ASYNC
+#include "log_queue.h"
+#endif
 
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
@@ -56,8 +63,31 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
   void loop() override;
+#endif
+#ifdef USE_LOGGER_ASYNC
+  /** Defer formatting and sending of log messages to loop(), through a queue of `size` messages.
+   *
+   * Logging then only copies the arguments into the queue, which any task can do without locking. Messages logged
+   * while the queue is full are dropped and counted, except for those of the main task, which processes the queue
+   * right away instead.
+   */
+  void set_async_queue_size(size_t size);
+  /// Number of messages dropped because the queue was full.
+  uint32_t get_dropped_messages() const { return this->dropped_total_; }
+#endif
+#ifdef USE_LOGGER_TOKENIZED
+  /** Set the tokens of the log calls that are sent tokenized, as a sorted array.
+   *
+   * Such messages are sent as the token and the encoded arguments instead of the formatted text, which saves the
+   * formatting on the device and most of the bytes on the wire. They are decoded with the token dictionary written
+   * at build time, see tokenizer.py. Messages with a token not in `tokens` are still sent as text.
+   */
+  void set_log_tokens(const uint32_t *tokens, size_t count) {
+    this->log_tokens_ = tokens;
+    this->log_tokens_count_ = count;
+  }
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
   void set_baud_rate(uint32_t baud_rate);
@@ -74,8 +104,12 @@ class Logger : public Component {
   UARTSelection get_uart() const;
 #endif
 
-  /// Set the log level of the specified tag.
+  /// Set the log level of the specified tag, replacing an earlier level of the same tag. Can be called at any time
+  /// from the main loop.
   void set_log_level(const std::string &tag, int log_level);
+  /// Set the log level of all tags without a level of their own, at most the level the firmware was compiled with.
+  void set_log_level(int log_level);
+  int get_log_level() const { return this->current_level_; }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -83,10 +117,27 @@ class Logger : public Component {
   void pre_setup();
   void dump_config() override;
 
+  /** The log level of `tag`.
+   *
+   * Without tags that have a level of their own, this is just the global level. Otherwise tags are compared by content
+   * the first time they are logged from the main task, after that their level is found by pointer in a small cache.
+   * Neither takes a lock. Like ESP-IDF, this expects tags to be string constants: a buffer that is reused for another
+   * tag keeps the level of the first one until a level is changed or the cache is cleared.
+   */
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+#ifdef USE_LOGGER_TOKENIZED
+  /** Register callbacks for a consumer that can decode tokenized messages.
+   *
+   * `tokens_callback` gets every tokenized message, see LogRecord::encode(), and sets its last argument to true if
+   * the consumer needs the text of the message as well. `callback` gets the text of all other messages, and that of
+   * tokenized messages whenever any consumer needs it, with its last argument set to true.
+   */
+  void add_on_log_callback(std::function<void(int, const char *, const char *, bool)> &&callback,
+                           std::function<void(int, const uint8_t *, size_t, bool *)> &&tokens_callback);
+#endif
 
   float get_setup_priority() const override;
 
@@ -96,7 +147,27 @@ class Logger : public Component {
 #endif
 
  protected:
-  void write_header_(int level, const char *tag, int line);
+  /// `thread_name` is the name of the task that logged, nullptr for the main task.
+  void write_header_(int level, const char *tag, int line, const char *thread_name);
+  const char *get_thread_name_();
+#ifdef USE_LOGGER_ASYNC
+  void log_async_(int level, const char *tag, int line, const char *format, va_list args);
+  void process_queue_();
+  /// Write the header and the message of `record` to the buffer.
+  void format_record_(const LogRecord &record);
+#endif
+#ifdef USE_LOGGER_TOKENIZED
+  bool is_tokenized_(uint32_t token) const;
+  void log_tokenized_(const LogRecord &record, uint32_t token);
+  /// Append `data` to the buffer in base64.
+  void write_base64_(const uint8_t *data, size_t len);
+#endif
+  bool is_main_task_() const;
+  /// Compare `tag` against tag_levels_ by content and add it to the tag cache if called from the main task.
+  int resolve_level_for_(const char *tag);
+  /// Remove all tags from the tag cache, they are looked up again the next time they are logged.
+  void clear_tag_cache_();
+  void update_max_level_();
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
   void write_msg_(const char *msg);
@@ -159,19 +230,77 @@ class Logger : public Component {
 #ifdef USE_ESP_IDF
   uart_port_t uart_num_;
 #endif
-  struct LogLevelOverride {
+  /// A tag with a level of its own. These are only ever added, so that other tasks can walk them without a lock.
+  struct TagLevel {
     std::string tag;
-    int level;
+    /// Hash of the tag, compared before the tag itself
+    uint32_t hash;
+    std::atomic<uint8_t> level;
+    std::atomic<TagLevel *> next;
   };
-  std::vector<LogLevelOverride> log_levels_;
+  /// Tags with a level of their own in the order they were added, only changed by the main task.
+  std::atomic<TagLevel *> tag_levels_{nullptr};
+  /// One bit for the hash of every tag in tag_levels_, tags whose bit isn't set have the global level.
+  std::atomic<uint32_t> tag_level_mask_{0};
+  struct TagCacheEntry {
+    std::atomic<const char *> tag{nullptr};
+    /// Level of the tag, TAG_DEFAULT_LEVEL for the global level
+    std::atomic<uint8_t> level{0};
+  };
+  static constexpr uint8_t TAG_CACHE_BITS = 6;
+  static constexpr size_t TAG_CACHE_SIZE = 1 << TAG_CACHE_BITS;
+  /// Number of entries looked at for a tag, in case of collisions
+  static constexpr size_t TAG_CACHE_PROBES = 8;
+  static constexpr uint8_t TAG_DEFAULT_LEVEL = 0xFF;
+  /** Levels of the tags by pointer, allocated before the first tag level is added.
+   *
+   * Only the main task writes it, so writes need no lock. Other tasks read it like a seqlock: tag_cache_sequence_ is
+   * odd while the cache is written, and a level read while it was odd or changed is looked up by content instead.
+   */
+  TagCacheEntry *tag_cache_{nullptr};
+  std::atomic<uint32_t> tag_cache_sequence_{0};
+  int current_level_{ESPHOME_LOG_LEVEL};
+  /// Highest level of the global level and all tag levels, messages above it are dropped without a lookup.
+  int max_level_{ESPHOME_LOG_LEVEL};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
   void *main_task_ = nullptr;
+#ifdef USE_LOGGER_ASYNC
+  std::unique_ptr<LogQueue> queue_;
+  /// Messages dropped since the queue was last processed, incremented by any task.
+  std::atomic<uint32_t> dropped_messages_{0};
+  uint32_t dropped_total_{0};
+  /// Whether messages of the main task are queued too, which starts with the first loop().
+  bool defer_main_task_{false};
+#endif
+#ifdef USE_LOGGER_TOKENIZED
+  static constexpr size_t TOKENIZED_BUFFER_SIZE = 192;
+  const uint32_t *log_tokens_{nullptr};
+  size_t log_tokens_count_{0};
+  uint8_t tokenized_buffer_[TOKENIZED_BUFFER_SIZE];
+  /// Text messages for the consumers registered with tokens_callback.
+  CallbackManager<void(int, const char *, const char *, bool)> log_fallback_callback_{};
+  CallbackManager<void(int, const uint8_t *, size_t, bool *)> log_tokens_callback_{};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
+template<typename... Ts> class LoggerSetLevelAction : public Action<Ts...>, public Parented<Logger> {
+ public:
+  TEMPLATABLE_VALUE(std::string, tag)
+  TEMPLATABLE_VALUE(int, level)
+
+  void play(Ts... x) override {
+    if (this->tag_.has_value()) {
+      this->parent_->set_log_level(this->tag_.value(x...), this->level_.value(x...));
+    } else {
+      this->parent_->set_log_level(this->level_.value(x...));
+    }
+  }
+};
+
 class LoggerMessageTrigger : public Trigger<int, const char *, const char *> {
  public:
   explicit LoggerMessageTrigger(Logger *parent, int level) {
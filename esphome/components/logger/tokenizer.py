@@ -0,0 +1,435 @@
+"""Tokenized log messages.
+
+With ``tokenized: true`` the logger sends the log calls found here not as text but
+as a token identifying the tag and format string, followed by the encoded
+arguments (see ``LogRecord::encode()`` in log_queue.h). The tokens of all log calls
+in the sources of a build are written to a dictionary in the build directory, which
+``esphome logs`` uses to turn the messages back into text.
+"""
+
+from __future__ import annotations
+
+import base64
+import itertools
+import json
+import logging
+from pathlib import Path
+import re
+import struct
+
+from esphome.core import CORE
+
+_LOGGER = logging.getLogger(__name__)
+
+DICTIONARY_FILE = "log_tokens.json"
+# Starts a serial line holding a tokenized message in base64
+SERIAL_PREFIX = "\x1eT"
+# First byte of a tokenized message
+MARKER = 0x00
+TRUNCATED = 0x80
+
+LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+LEVEL_COLORS = [
+    "",
+    "\033[1;31m",
+    "\033[0;33m",
+    "\033[0;32m",
+    "\033[0;35m",
+    "\033[0;36m",
+    "\033[0;37m",
+    "\033[0;38m",
+]
+RESET_COLOR = "\033[0m"
+
+# Severity of the ESP_LOGx macros, as in LOG_LEVEL_SEVERITY
+MACRO_SEVERITY = {"E": 1, "W": 2, "I": 3, "CONFIG": 4, "D": 5, "V": 6, "VV": 7}
+
+# The length modifiers the <inttypes.h> macros expand to differ between toolchains,
+# so a format string using them gets a token for each possibility.
+PRI_LENGTHS = {
+    "8": ("hh", ""),
+    "16": ("h", ""),
+    "32": ("l", ""),
+    "64": ("ll", "l"),
+    "PTR": ("", "l"),
+}
+
+_STRING_LITERAL = r'"(?:[^"\\\n]|\\.)*"'
+_PRI_MACRO = r"PRI[diouxX](?:8|16|32|64|PTR)"
+_LOG_CALL_RE = re.compile(
+    r"\bESP_LOG(VV|V|D|CONFIG|I|W|E)\s*\(\s*([A-Za-z_]\w*|"
+    + _STRING_LITERAL
+    + r")\s*,\s*((?:(?:"
+    + _STRING_LITERAL
+    + "|"
+    + _PRI_MACRO
+    + r")\s*)+)[,)]"
+)
+_FORMAT_PART_RE = re.compile(rf"({_STRING_LITERAL})|PRI[diouxX](8|16|32|64|PTR)")
+_CONSTANT_RE = re.compile(r"\b([A-Za-z_]\w*)\s*=\s*(" + _STRING_LITERAL + r")\s*;")
+_INCLUDE_RE = re.compile(r'^\s*#\s*include\s*"([^"]+)"', re.MULTILINE)
+_ESCAPES = {
+    "n": b"\n",
+    "t": b"\t",
+    "r": b"\r",
+    "a": b"\a",
+    "b": b"\b",
+    "f": b"\f",
+    "v": b"\v",
+    "e": b"\033",
+    "\\": b"\\",
+    '"': b'"',
+    "'": b"'",
+    "?": b"?",
+}
+_ESCAPE_RE = re.compile(r"\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)")
+
+
+def fnv1(data: bytes) -> int:
+    """32-bit FNV-1 hash, like ``LogRecord::get_token()``."""
+    value = 2166136261
+    for byte in data:
+        value = ((value * 16777619) & 0xFFFFFFFF) ^ byte
+    return value
+
+
+def token(tag: bytes, fmt: bytes) -> int:
+    return fnv1(tag + b"\0" + fmt)
+
+
+def unescape(literal: str) -> bytes:
+    """Convert the contents of a C string literal to the bytes it stands for."""
+
+    def replace(match: re.Match) -> str:
+        escape = match.group(1)
+        if escape[0] == "x":
+            value = int(escape[1:], 16) & 0xFF
+        elif escape[0] in "01234567":
+            value = int(escape, 8) & 0xFF
+        else:
+            return _ESCAPES.get(escape, escape.encode()).decode("latin-1")
+        return chr(value)
+
+    # Work on latin-1 so every character is one byte, after encoding the source as UTF-8
+    text = literal.encode("utf-8").decode("latin-1")
+    return _ESCAPE_RE.sub(replace, text).encode("latin-1")
+
+
+def _format_variants(source: str) -> list[bytes]:
+    parts = []
+    widths = []
+    for match in _FORMAT_PART_RE.finditer(source):
+        if match.group(1) is not None:
+            parts.append(unescape(match.group(1)[1:-1]))
+        else:
+            conversion = match.group(0)[3]
+            width = match.group(2)
+            parts.append((width, conversion))
+            if width not in widths:
+                widths.append(width)
+
+    variants = []
+    for choice in itertools.product(*(PRI_LENGTHS[w] for w in widths)):
+        lengths = dict(zip(widths, choice))
+        variants.append(
+            b"".join(
+                part
+                if isinstance(part, bytes)
+                else (lengths[part[0]] + part[1]).encode()
+                for part in parts
+            )
+        )
+    return variants
+
+
+def scan_source(path: Path, constants: dict[str, bytes], max_severity: int):
+    """Yield the tag and format strings of the log calls in a source file."""
+    text = path.read_text(encoding="utf-8", errors="replace")
+    for match in _LOG_CALL_RE.finditer(text):
+        if MACRO_SEVERITY[match.group(1)] > max_severity:
+            continue
+        tag = match.group(2)
+        if tag.startswith('"'):
+            tag_bytes = unescape(tag[1:-1])
+        elif tag in constants:
+            tag_bytes = constants[tag]
+        else:
+            continue
+        for fmt in _format_variants(match.group(3)):
+            yield tag_bytes, fmt
+
+
+def find_constants(text: str) -> dict[str, bytes]:
+    """Find the string constants like TAG defined in a source text."""
+    constants = {}
+    for match in _CONSTANT_RE.finditer(text):
+        constants.setdefault(match.group(1), unescape(match.group(2)[1:-1]))
+    return constants
+
+
+def _directory_constants(
+    own: dict[Path, dict[str, bytes]],
+) -> dict[Path, dict[str, bytes]]:
+    """The constants defined with a single value by the files of each directory."""
+    values: dict[Path, dict[str, set[bytes]]] = {}
+    for path, constants in own.items():
+        found = values.setdefault(path.parent, {})
+        for name, value in constants.items():
+            found.setdefault(name, set()).add(value)
+    return {
+        directory: {
+            name: next(iter(options))
+            for name, options in found.items()
+            if len(options) == 1
+        }
+        for directory, found in values.items()
+    }
+
+
+def _resolve_constants(
+    path: Path,
+    text: str,
+    own: dict[Path, dict[str, bytes]],
+    shared: dict[Path, dict[str, bytes]],
+) -> dict[str, bytes]:
+    """The constants a log call in `path` can refer to.
+
+    The constants of the file itself come first, then those of the headers it
+    includes from the same directory, then those defined with a single value in
+    its directory. A constant like TAG that differs between the files of a
+    directory is thus never taken from another file.
+    """
+    constants = dict(shared[path.parent])
+    for include in _INCLUDE_RE.findall(text):
+        header = path.parent / include
+        if header in own:
+            constants.update(own[header])
+    constants.update(own[path])
+    return constants
+
+
+def build_dictionary(paths: list[Path], max_severity: int) -> dict[int, tuple]:
+    """Collect the tokens of all log calls in `paths`.
+
+    Tokens with more than one tag and format string are left out, so their
+    messages are sent as text.
+    """
+    texts = {
+        path: path.read_text(encoding="utf-8", errors="replace") for path in paths
+    }
+    own = {path: find_constants(text) for path, text in texts.items()}
+    shared = _directory_constants(own)
+
+    tokens: dict[int, tuple] = {}
+    collisions = set()
+    for path in paths:
+        constants = _resolve_constants(path, texts[path], own, shared)
+        for tag, fmt in scan_source(path, constants, max_severity):
+            value = token(tag, fmt)
+            if tokens.setdefault(value, (tag, fmt)) != (tag, fmt):
+                collisions.add(value)
+    for value in collisions:
+        _LOGGER.debug("Log token %08x is ambiguous, sending as text", value)
+        del tokens[value]
+    return tokens
+
+
+def write_dictionary(path: Path, tokens: dict[int, tuple]) -> None:
+    data = {
+        f"{value:08x}": {
+            "tag": tag.decode("utf-8", "replace"),
+            "format": fmt.decode("utf-8", "replace"),
+        }
+        for value, (tag, fmt) in sorted(tokens.items())
+    }
+    path.write_text(json.dumps(data, indent=1, ensure_ascii=False), encoding="utf-8")
+
+
+def load_dictionary(path: Path) -> dict[int, tuple] | None:
+    try:
+        data = json.loads(Path(path).read_text(encoding="utf-8"))
+    except (OSError, ValueError):
+        return None
+    return {int(key, 16): (v["tag"], v["format"]) for key, v in data.items()}
+
+
+def load_build_dictionary(config) -> dict[int, tuple] | None:
+    """Load the dictionary of the build if `config` has tokenized logging enabled."""
+    if not config.get("logger", {}).get("tokenized"):
+        return None
+    tokens = load_dictionary(Path(CORE.relative_build_path(DICTIONARY_FILE)))
+    if tokens is None:
+        _LOGGER.warning(
+            "No log token dictionary found, compile the configuration to decode "
+            "tokenized log messages"
+        )
+    return tokens
+
+
+class _Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def byte(self) -> int:
+        if self.pos >= len(self.data):
+            raise EOFError
+        self.pos += 1
+        return self.data[self.pos - 1]
+
+    def bytes(self, length: int) -> bytes:
+        if self.pos + length > len(self.data):
+            raise EOFError
+        self.pos += length
+        return self.data[self.pos - length : self.pos]
+
+    def varint(self) -> int:
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def signed(self) -> int:
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+
+_SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|L|q|z|j|t)?(?P<conversion>[diouxXcfFeEgGaApsn%])"
+)
+
+
+def _render_value(spec: re.Match, reader: _Reader) -> str:
+    conversion = spec.group("conversion")
+    if conversion == "%":
+        return "%"
+    stars = [
+        reader.signed()
+        for group in ("width", "precision")
+        if spec.group(group) == "*"
+    ]
+    length = spec.group("length")
+    python_spec = (
+        "%"
+        + spec.group("flags")
+        + (spec.group("width") or "")
+        + (
+            "." + spec.group("precision")
+            if spec.group("precision") is not None
+            else ""
+        )
+    )
+    if conversion == "n":
+        return ""
+    if conversion in "di":
+        value = reader.signed()
+        if length == "hh":
+            value = (value + 0x80 & 0xFF) - 0x80
+        elif length == "h":
+            value = (value + 0x8000 & 0xFFFF) - 0x8000
+        return (python_spec + "d") % (*stars, value)
+    if conversion in "ouxXc":
+        value = reader.varint()
+        if length == "hh" or conversion == "c":
+            value &= 0xFF
+        elif length == "h":
+            value &= 0xFFFF
+        if conversion == "u":
+            conversion = "d"
+        elif conversion == "o" and "#" in python_spec:
+            # Python writes the alternate form of octal as 0o
+            python_spec = python_spec.replace("#", "")
+            return (python_spec + "s") % (*stars, f"0{value:o}" if value else "0")
+        return (python_spec + conversion) % (*stars, value)
+    if conversion in "fFeEgGaA":
+        (value,) = struct.unpack("<d", reader.bytes(8))
+        if conversion in "aA":
+            # float.hex() always writes all 13 hex digits of the mantissa
+            mantissa, exponent = value.hex().split("p")
+            if "." in mantissa:
+                mantissa = mantissa.rstrip("0").rstrip(".")
+            text = f"{mantissa}p{exponent}"
+            return text.upper() if conversion == "A" else text
+        return (python_spec + conversion) % (*stars, value)
+    if conversion == "p":
+        return (python_spec + "s") % (*stars, hex(reader.varint()))
+    # %s
+    value = reader.bytes(reader.varint()).decode("utf-8", "backslashreplace")
+    return (python_spec + "s") % (*stars, value)
+
+
+def format_message(fmt: str, reader: _Reader) -> str:
+    """Format `fmt` with the encoded arguments.
+
+    Like on the device, formatting stops at the first missing argument.
+    """
+    out = []
+    pos = 0
+    for spec in _SPEC_RE.finditer(fmt):
+        out.append(fmt[pos : spec.start()])
+        pos = spec.end()
+        try:
+            out.append(_render_value(spec, reader))
+        except EOFError:
+            return "".join(out)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(payload: bytes, tokens: dict[int, tuple] | None) -> str | None:
+    """Turn a tokenized message into the line the device would have logged.
+
+    Returns None if `payload` is not a tokenized message.
+    """
+    if not payload or payload[0] != MARKER:
+        return None
+    reader = _Reader(payload)
+    try:
+        reader.byte()
+        level = reader.byte() & ~TRUNCATED
+        line = reader.varint()
+        (value,) = struct.unpack("<I", reader.bytes(4))
+        thread_name = reader.bytes(reader.byte()).decode("utf-8", "backslashreplace")
+    except EOFError:
+        return None
+    level = min(level, 7)
+    color = LEVEL_COLORS[level]
+    letter = LEVEL_LETTERS[level]
+
+    entry = tokens.get(value) if tokens is not None else None
+    if entry is None:
+        tag = "?"
+        message = f"<unknown log token {value:08x}: {payload[reader.pos :].hex()}>"
+    else:
+        tag, fmt = entry
+        message = format_message(fmt, reader)
+    if thread_name:
+        header = f"{color}[{letter}][{tag}:{line:03}]\033[1;31m[{thread_name}]{color}: "
+    else:
+        header = f"{color}[{letter}][{tag}:{line:03}]: "
+    return header + message + RESET_COLOR
+
+
+def decode_serial_line(line: str, tokens: dict[int, tuple] | None) -> str | None:
+    """Decode a serial line holding a tokenized message, None for all other lines.
+
+    Anything before the message, like the timestamp of the host platform, is kept.
+    """
+    start = line.find(SERIAL_PREFIX)
+    if start == -1:
+        return None
+    try:
+        payload = base64.b64decode(
+            line[start + len(SERIAL_PREFIX) :].strip(), validate=True
+        )
+    except ValueError:
+        return None
+    message = decode(payload, tokens)
+    if message is None:
+        return None
+    return line[:start] + message
@@ -1,6 +1,8 @@
 #include "prometheus_handler.h"
 #ifdef USE_NETWORK
 #include "esphome/core/application.h"
+#include <cinttypes>
+#include <cstdio>
 
 namespace esphome {
 namespace prometheus {
@@ -50,6 +52,12 @@ void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
     this->lock_row_(stream, obj);
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  this->component_profile_type_(stream);
+  for (auto *obj : App.get_components())
+    this->component_profile_row_(stream, obj);
+#endif
+
   req->send(stream);
 }
 
@@ -349,6 +357,66 @@ void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj)
 }
 #endif
 
+#ifdef USE_LOOP_PROFILER
+// Prometheus expects durations in seconds, print microseconds as such without going through float
+static std::string us_to_seconds(uint64_t us) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%" PRIu32 ".%06" PRIu32, static_cast<uint32_t>(us / 1000000),
+           static_cast<uint32_t>(us % 1000000));
+  return buf;
+}
+
+void PrometheusHandler::component_profile_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_component_setup_duration_seconds gauge\n"));
+  stream->print(F("#TYPE esphome_component_loop_duration_seconds histogram\n"));
+  stream->print(F("#TYPE esphome_component_scheduler_duration_seconds histogram\n"));
+}
+void PrometheusHandler::component_profile_row_(AsyncResponseStream *stream, Component *obj) {
+  const ComponentProfile *profile = obj->get_profile();
+  if (profile == nullptr)
+    return;
+  const char *component = obj->get_component_source();
+  stream->print(F("esphome_component_setup_duration_seconds{component=\""));
+  stream->print(component);
+  stream->print(F("\"} "));
+  stream->print(us_to_seconds(profile->setup_us).c_str());
+  stream->print(F("\n"));
+  this->histogram_rows_(stream, "esphome_component_loop_duration_seconds", component, profile->loop);
+  this->histogram_rows_(stream, "esphome_component_scheduler_duration_seconds", component, profile->scheduler);
+}
+void PrometheusHandler::histogram_rows_(AsyncResponseStream *stream, const char *metric, const char *component,
+                                        const ExecutionHistogram &histogram) {
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < ExecutionHistogram::BUCKET_COUNT; i++) {
+    cumulative += histogram.get_bucket(i);
+    stream->print(metric);
+    stream->print(F("_bucket{component=\""));
+    stream->print(component);
+    stream->print(F("\",le=\""));
+    if (i == ExecutionHistogram::BUCKET_COUNT - 1) {
+      stream->print(F("+Inf"));
+    } else {
+      stream->print(us_to_seconds(ExecutionHistogram::get_bucket_upper_bound_us(i)).c_str());
+    }
+    stream->print(F("\"} "));
+    stream->print(cumulative);
+    stream->print(F("\n"));
+  }
+  stream->print(metric);
+  stream->print(F("_sum{component=\""));
+  stream->print(component);
+  stream->print(F("\"} "));
+  stream->print(us_to_seconds(histogram.get_total_us()).c_str());
+  stream->print(F("\n"));
+  stream->print(metric);
+  stream->print(F("_count{component=\""));
+  stream->print(component);
+  stream->print(F("\"} "));
+  stream->print(histogram.get_count());
+  stream->print(F("\n"));
+}
+#endif
+
 }  // namespace prometheus
 }  // namespace esphome
 #endif
@@ -110,6 +110,16 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  /// Return the type for prometheus
+  void component_profile_type_(AsyncResponseStream *stream);
+  /// Return the execution times of a component as prometheus data points
+  void component_profile_row_(AsyncResponseStream *stream, Component *obj);
+  /// Return a single execution time histogram as prometheus data points
+  void histogram_rows_(AsyncResponseStream *stream, const char *metric, const char *component,
+                       const ExecutionHistogram &histogram);
+#endif
+
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
@@ -155,7 +155,7 @@ void RP2040PIOLEDStripLightOutput::write_state(light::LightState *state) {
   dma_channel_transfer_from_buffer_now(this->dma_chan_, this->buf_, this->get_buffer_size_());
 }
 
-light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t index) const {
+light::AddressableLight::PixelBuffer RP2040PIOLEDStripLightOutput::get_pixel_buffer() const {
   int32_t r = 0, g = 0, b = 0, w = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
@@ -189,11 +189,25 @@ light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t inde
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
-  return {this->buf_ + (index * multiplier) + r,
-          this->buf_ + (index * multiplier) + g,
-          this->buf_ + (index * multiplier) + b,
-          this->is_rgbw_ ? this->buf_ + (index * multiplier) + 3 : nullptr,
+  PixelBuffer buffer;
+  buffer.data = this->buf_;
+  buffer.effect_data = this->effect_data_;
+  buffer.stride = this->is_rgbw_ ? 4 : 3;
+  buffer.red = r;
+  buffer.green = g;
+  buffer.blue = b;
+  if (this->is_rgbw_)
+    buffer.white = 3;
+  return buffer;
+}
+
+light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t index) const {
+  const PixelBuffer buffer = this->get_pixel_buffer();
+  uint8_t *pixel = buffer.data + index * buffer.stride;
+  return {pixel + buffer.red,
+          pixel + buffer.green,
+          pixel + buffer.blue,
+          buffer.white >= 0 ? pixel + buffer.white : nullptr,
           &this->effect_data_[index],
           &this->correction_};
 }
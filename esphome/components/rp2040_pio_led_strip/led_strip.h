@@ -91,6 +91,8 @@ class RP2040PIOLEDStripLightOutput : public light::AddressableLight {
 
   void dump_config() override;
 
+  PixelBuffer get_pixel_buffer() const override;
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
 
@@ -1,4 +1,5 @@
 #include "filter.h"
+#include <algorithm>
 #include <cmath>
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -9,6 +10,11 @@ namespace sensor {
 
 static const char *const TAG = "sensor.filter";
 
+static constexpr uint32_t THROTTLE_AVERAGE_ID = fnv1_hash("throttle_average");
+static constexpr uint32_t TIMEOUT_ID = fnv1_hash("timeout");
+static constexpr uint32_t DEBOUNCE_ID = fnv1_hash("debounce");
+static constexpr uint32_t HEARTBEAT_ID = fnv1_hash("heartbeat");
+
 // Filter
 void Filter::input(float value) {
   ESP_LOGVV(TAG, "Filter(%p)::input(%f)", this, value);
@@ -16,6 +22,37 @@ void Filter::input(float value) {
   if (out.has_value())
     this->output(*out);
 }
+size_t Filter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      values[out++] = *value;
+  }
+  return out;
+}
+void Filter::input_batch(const float *values, size_t count) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_batch(%zu values)", this, count);
+  float block[BATCH_SIZE];
+  while (count > 0) {
+    size_t n = std::min(count, BATCH_SIZE);
+    std::copy(values, values + n, block);
+    this->process_batch_(block, n);
+    values += n;
+    count -= n;
+  }
+}
+void Filter::process_batch_(float *values, size_t count) {
+  count = this->new_values(values, count);
+  if (count == 0)
+    return;
+  if (this->next_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->parent_->internal_send_state_to_frontend(values[i]);
+  } else {
+    this->next_->process_batch_(values, count);
+  }
+}
 void Filter::output(float value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
@@ -33,38 +70,23 @@ void Filter::initialize(Sensor *parent, Filter *next) {
 
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    size_t size = this->window_.size();
+    if (size) {
+      if (size % 2) {
+        median = this->window_.get(size / 2);
+      } else {
+        median = (this->window_.get(size / 2) + this->window_.get((size / 2) - 1)) / 2.0f;
       }
     }
 
@@ -89,38 +111,24 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    size_t size = this->window_.size();
+    if (size) {
+      // The 0 quantile is the smallest value
+      size_t position = std::max(ceilf(size * this->quantile_), 1.0f) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %zu/%zu", this, position + 1, size);
+      result = this->window_.get(position);
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -131,26 +139,17 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
-
+    float min = this->window_.get();
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
   }
@@ -159,26 +158,17 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
-
+    float max = this->window_.get();
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
   }
@@ -188,61 +178,69 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->queue_.init(window_size); }
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
+  if (this->new_values(&value, 1) == 0)
+    return {};
+  ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value SENDING %f", this, value);
+  return value;
+}
+size_t SlidingWindowMovingAverageFilter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    this->queue_.push_back(values[i]);
+    if (++this->send_at_ < this->send_every_)
+      continue;
     this->send_at_ = 0;
 
     float sum = 0;
     size_t valid_count = 0;
-    for (auto v : this->queue_) {
+    for (size_t j = 0; j < this->queue_.size(); j++) {
+      float v = this->queue_[j];
       if (!std::isnan(v)) {
         sum += v;
         valid_count++;
       }
     }
-
-    float average = NAN;
-    if (valid_count) {
-      average = sum / valid_count;
-    }
-
-    ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
-    return average;
+    values[out++] = valid_count ? sum / valid_count : NAN;
   }
-  return {};
+  return out;
 }
 
 // ExponentialMovingAverageFilter
 ExponentialMovingAverageFilter::ExponentialMovingAverageFilter(float alpha, size_t send_every, size_t send_first_at)
     : send_every_(send_every), send_at_(send_every - send_first_at), alpha_(alpha) {}
 optional<float> ExponentialMovingAverageFilter::new_value(float value) {
-  if (!std::isnan(value)) {
-    if (this->first_value_) {
-      this->accumulator_ = value;
-      this->first_value_ = false;
-    } else {
-      this->accumulator_ = (this->alpha_ * value) + (1.0f - this->alpha_) * this->accumulator_;
+  ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f)", this, value);
+  if (this->new_values(&value, 1) == 0)
+    return {};
+  ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value SENDING %f", this, value);
+  return value;
+}
+size_t ExponentialMovingAverageFilter::new_values(float *values, size_t count) {
+  const float alpha = this->alpha_;
+  float accumulator = this->accumulator_;
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    const float value = values[i];
+    if (!std::isnan(value)) {
+      if (this->first_value_) {
+        accumulator = value;
+        this->first_value_ = false;
+      } else {
+        accumulator = (alpha * value) + (1.0f - alpha) * accumulator;
+      }
+    }
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      values[out++] = std::isnan(value) ? value : accumulator;
     }
   }
-
-  const float average = std::isnan(value) ? value : this->accumulator_;
-  ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
-
-  if (++this->send_at_ >= this->send_every_) {
-    ESP_LOGVV(TAG, "ExponentialMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
-    this->send_at_ = 0;
-    return average;
-  }
-  return {};
+  this->accumulator_ = accumulator;
+  return out;
 }
 void ExponentialMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
 void ExponentialMovingAverageFilter::set_alpha(float alpha) { this->alpha_ = alpha; }
@@ -261,7 +259,7 @@ optional<float> ThrottleAverageFilter::new_value(float value) {
   return {};
 }
 void ThrottleAverageFilter::setup() {
-  this->set_interval("throttle_average", this->time_period_, [this]() {
+  this->set_interval(THROTTLE_AVERAGE_ID, this->time_period_, [this]() {
     ESP_LOGVV(TAG, "ThrottleAverageFilter(%p)::interval(sum=%f, n=%i)", this, this->sum_, this->n_);
     if (this->n_ == 0) {
       if (this->have_nan_)
@@ -291,11 +289,23 @@ optional<float> LambdaFilter::new_value(float value) {
 OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
 
 optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
+size_t OffsetFilter::new_values(float *values, size_t count) {
+  const float offset = this->offset_;
+  for (size_t i = 0; i < count; i++)
+    values[i] += offset;
+  return count;
+}
 
 // MultiplyFilter
 MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
 
 optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
+size_t MultiplyFilter::new_values(float *values, size_t count) {
+  const float multiplier = this->multiplier_;
+  for (size_t i = 0; i < count; i++)
+    values[i] *= multiplier;
+  return count;
+}
 
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
@@ -383,7 +393,7 @@ void OrFilter::initialize(Sensor *parent, Filter *next) {
 
 // TimeoutFilter
 optional<float> TimeoutFilter::new_value(float value) {
-  this->set_timeout("timeout", this->time_period_, [this]() { this->output(this->value_); });
+  this->set_timeout(TIMEOUT_ID, this->time_period_, [this]() { this->output(this->value_); });
   return value;
 }
 
@@ -392,7 +402,7 @@ float TimeoutFilter::get_setup_priority() const { return setup_priority::HARDWAR
 
 // DebounceFilter
 optional<float> DebounceFilter::new_value(float value) {
-  this->set_timeout("debounce", this->time_period_, [this, value]() { this->output(value); });
+  this->set_timeout(DEBOUNCE_ID, this->time_period_, [this, value]() { this->output(value); });
 
   return {};
 }
@@ -411,7 +421,7 @@ optional<float> HeartbeatFilter::new_value(float value) {
   return {};
 }
 void HeartbeatFilter::setup() {
-  this->set_interval("heartbeat", this->time_period_, [this]() {
+  this->set_interval(HEARTBEAT_ID, this->time_period_, [this]() {
     ESP_LOGVV(TAG, "HeartbeatFilter(%p)::interval(has_value=%s, last_input=%f)", this, YESNO(this->has_value_),
               this->last_input_);
     if (!this->has_value_)
@@ -429,6 +439,19 @@ optional<float> CalibrateLinearFilter::new_value(float value) {
   }
   return NAN;
 }
+size_t CalibrateLinearFilter::new_values(float *values, size_t count) {
+  if (this->linear_functions_.size() == 1 && !std::isfinite(this->linear_functions_[0][2])) {
+    // A single function without an upper bound, the common case of a calibration with two points
+    const float slope = this->linear_functions_[0][0];
+    const float bias = this->linear_functions_[0][1];
+    for (size_t i = 0; i < count; i++)
+      values[i] = (values[i] * slope) + bias;
+    return count;
+  }
+  for (size_t i = 0; i < count; i++)
+    values[i] = *this->new_value(values[i]);
+  return count;
+}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
   float res = 0.0f;
@@ -439,6 +462,21 @@ optional<float> CalibratePolynomialFilter::new_value(float value) {
   }
   return res;
 }
+size_t CalibratePolynomialFilter::new_values(float *values, size_t count) {
+  // Coefficient by coefficient over the whole block, which sums in the same order as new_value()
+  float res[BATCH_SIZE];
+  float x[BATCH_SIZE];
+  std::fill(res, res + count, 0.0f);
+  std::fill(x, x + count, 1.0f);
+  for (float coefficient : this->coefficients_) {
+    for (size_t i = 0; i < count; i++) {
+      res[i] += x[i] * coefficient;
+      x[i] *= values[i];
+    }
+  }
+  std::copy(res, res + count, values);
+  return count;
+}
 
 ClampFilter::ClampFilter(float min, float max, bool ignore_out_of_range)
     : min_(min), max_(max), ignore_out_of_range_(ignore_out_of_range) {}
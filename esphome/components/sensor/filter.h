@@ -1,10 +1,11 @@
 #pragma once
 
-#include <queue>
 #include <utility>
 #include <vector>
+#include "esphome/core/circular_buffer.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "window_statistics.h"
 
 namespace esphome {
 namespace sensor {
@@ -29,16 +30,39 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** Process a block of values, with the same result as calling new_value() for each of them in order.
+   *
+   * The values to push out are written back to the front of `values`. Filters that are cheap per value override this
+   * with a plain loop over the block, which the compiler can unroll or vectorize, instead of a virtual call and an
+   * optional per value. The default implementation calls new_value().
+   *
+   * @param values The new values, at most BATCH_SIZE.
+   * @param count The number of new values.
+   * @return The number of values to push out.
+   */
+  virtual size_t new_values(float *values, size_t count);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
+  /// Number of bytes of heap memory this filter reserved for its state, like the values of a window.
+  virtual size_t memory_usage() const { return 0; }
+
   void input(float value);
+  /// Pass a block of values through the filter chain, like calling input() for each of them in order.
+  void input_batch(const float *values, size_t count);
 
   void output(float value);
 
+  /// Number of values the filter chain processes at once, blocks passed to input_batch() are split up into these.
+  static constexpr size_t BATCH_SIZE = 32;
+
  protected:
   friend Sensor;
 
+  /// Run new_values() on a block of at most BATCH_SIZE values and pass the result down the chain.
+  void process_batch_(float *values, size_t count);
+
   Filter *next_{nullptr};
   Sensor *parent_{nullptr};
 };
@@ -61,16 +85,16 @@ class QuantileFilter : public Filter {
   explicit QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
 
   optional<float> new_value(float value) override;
+  size_t memory_usage() const override { return this->window_.memory_usage(); }
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
   float quantile_;
 };
 
@@ -91,15 +115,15 @@ class MedianFilter : public Filter {
   explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t memory_usage() const override { return this->window_.memory_usage(); }
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple skip filter.
@@ -137,15 +161,15 @@ class MinFilter : public Filter {
   explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t memory_usage() const override { return this->window_.memory_usage(); }
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  ExtremumWindow<std::less<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -165,15 +189,15 @@ class MaxFilter : public Filter {
   explicit MaxFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t memory_usage() const override { return this->window_.memory_usage(); }
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  ExtremumWindow<std::greater<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -194,15 +218,16 @@ class SlidingWindowMovingAverageFilter : public Filter {
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
+  size_t memory_usage() const override { return this->queue_.memory_usage(); }
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  CircularBuffer<float> queue_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -215,6 +240,7 @@ class ExponentialMovingAverageFilter : public Filter {
   ExponentialMovingAverageFilter(float alpha, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
   void set_send_every(size_t send_every);
   void set_alpha(float alpha);
@@ -276,6 +302,7 @@ class OffsetFilter : public Filter {
   explicit OffsetFilter(float offset);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float offset_;
@@ -287,6 +314,7 @@ class MultiplyFilter : public Filter {
   explicit MultiplyFilter(float multiplier);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float multiplier_;
@@ -397,6 +425,7 @@ class CalibrateLinearFilter : public Filter {
   CalibrateLinearFilter(std::vector<std::array<float, 3>> linear_functions)
       : linear_functions_(std::move(linear_functions)) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<std::array<float, 3>> linear_functions_;
@@ -406,6 +435,7 @@ class CalibratePolynomialFilter : public Filter {
  public:
   CalibratePolynomialFilter(std::vector<float> coefficients) : coefficients_(std::move(coefficients)) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<float> coefficients_;
@@ -1,4 +1,5 @@
 #include "sensor.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -6,6 +7,10 @@ namespace sensor {
 
 static const char *const TAG = "sensor";
 
+std::vector<Sensor *> Sensor::dirty_sensors_;        // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::vector<Sensor *> Sensor::dispatching_sensors_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uint32_t Sensor::coalesced_state_count_ = 0;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 std::string state_class_to_string(StateClass state_class) {
   switch (state_class) {
     case STATE_CLASS_MEASUREMENT:
@@ -20,7 +25,13 @@ std::string state_class_to_string(StateClass state_class) {
   }
 }
 
-Sensor::Sensor() : state(NAN), raw_state(NAN) {}
+Sensor::Sensor() : state(NAN), raw_state(NAN) {
+  static bool dispatch_registered = false;
+  if (!dispatch_registered) {
+    App.add_loop_end_hook(Sensor::dispatch_frontend_states);
+    dispatch_registered = true;
+  }
+}
 
 int8_t Sensor::get_accuracy_decimals() {
   if (this->accuracy_decimals_.has_value())
@@ -48,11 +59,44 @@ void Sensor::publish_state(float state) {
     this->filter_list_->input(state);
   }
 }
+void Sensor::publish_states(const float *states, size_t count) {
+  if (count == 0)
+    return;
+  this->raw_state = states[count - 1];
+  for (size_t i = 0; i < count; i++)
+    this->raw_callback_.call(states[i]);
+
+  ESP_LOGV(TAG, "'%s': Received %zu new states", this->name_.c_str(), count);
 
-void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
-void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
+  if (this->filter_list_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->internal_send_state_to_frontend(states[i]);
+  } else {
+    this->filter_list_->input_batch(states, count);
+  }
+}
+
+void Sensor::add_on_state_callback(InlineFunction<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
+void Sensor::add_on_raw_state_callback(InlineFunction<void(float)> &&callback) {
   this->raw_callback_.add(std::move(callback));
 }
+void Sensor::add_on_frontend_state_callback(InlineFunction<void(float)> &&callback) {
+  this->frontend_callback_.add(std::move(callback));
+}
+
+void Sensor::dispatch_frontend_states() {
+  // Sensors published by a frontend callback are kept for the next iteration, which also keeps the iterators valid
+  if (dirty_sensors_.empty())
+    return;
+  dispatching_sensors_.swap(dirty_sensors_);
+  for (Sensor *sensor : dispatching_sensors_) {
+    sensor->dirty_ = false;
+    ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", sensor->get_name().c_str(), sensor->state,
+             sensor->get_unit_of_measurement().c_str(), sensor->get_accuracy_decimals());
+    sensor->frontend_callback_.call(sensor->state);
+  }
+  dispatching_sensors_.clear();
+}
 
 void Sensor::add_filter(Filter *filter) {
   // inefficient, but only happens once on every sensor setup and nobody's going to have massive amounts of
@@ -83,6 +127,12 @@ void Sensor::clear_filters() {
   }
   this->filter_list_ = nullptr;
 }
+size_t Sensor::get_filter_memory_usage() const {
+  size_t usage = 0;
+  for (Filter *filter = this->filter_list_; filter != nullptr; filter = filter->next_)
+    usage += filter->memory_usage();
+  return usage;
+}
 float Sensor::get_state() const { return this->state; }
 float Sensor::get_raw_state() const { return this->raw_state; }
 std::string Sensor::unique_id() { return ""; }
@@ -90,9 +140,14 @@ std::string Sensor::unique_id() { return ""; }
 void Sensor::internal_send_state_to_frontend(float state) {
   this->has_state_ = true;
   this->state = state;
-  ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
-           this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
   this->callback_.call(state);
+  // The frontends only get the last state of this loop iteration
+  if (this->dirty_) {
+    coalesced_state_count_++;
+    return;
+  }
+  this->dirty_ = true;
+  dirty_sensors_.push_back(this);
 }
 bool Sensor::has_state() const { return this->has_state_; }
 
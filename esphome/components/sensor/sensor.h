@@ -29,6 +29,9 @@ namespace sensor {
     if ((obj)->get_force_update()) { \
       ESP_LOGV(TAG, "%s  Force Update: YES", prefix); \
     } \
+    if ((obj)->get_filter_memory_usage() != 0) { \
+      ESP_LOGCONFIG(TAG, "%s  Filter Memory: %zu bytes", prefix, (obj)->get_filter_memory_usage()); \
+    } \
   }
 
 #define SUB_SENSOR(name) \
@@ -100,6 +103,9 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   /// Clear the entire filter chain.
   void clear_filters();
 
+  /// Number of bytes of heap memory reserved by the filters, mostly for their windows.
+  size_t get_filter_memory_usage() const;
+
   /// Getter-syntax for .state.
   float get_state() const;
   /// Getter-syntax for .raw_state
@@ -114,12 +120,36 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
    */
   void publish_state(float state);
 
+  /** Publish a block of states, like calling publish_state() for each of them in order.
+   *
+   * Meant for sources that sample faster than they publish, like an ADC in continuous mode. The filters process the
+   * states as a block (see Filter::new_values()). The raw state callbacks are all called before the first filtered
+   * state comes out of the filters.
+   *
+   * @param states The states, in the order they were measured.
+   * @param count The number of states.
+   */
+  void publish_states(const float *states, size_t count);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
-  void add_on_state_callback(std::function<void(float)> &&callback);
+  void add_on_state_callback(InlineFunction<void(float)> &&callback);
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(float)> &&callback);
+  void add_on_raw_state_callback(InlineFunction<void(float)> &&callback);
+  /** Add a callback for a frontend (API, web server, MQTT) that needs the latest state, not every state.
+   *
+   * Unlike the state callbacks, these are not called by publish_state() but by dispatch_frontend_states(), once per
+   * loop iteration, with the last state published in that iteration. A sensor publishing at 1 kHz thus only reaches
+   * the frontends with the state of every loop iteration instead of every publish.
+   */
+  void add_on_frontend_state_callback(InlineFunction<void(float)> &&callback);
+
+  /// Call the frontend callbacks of every sensor that published a state since the last call. Registered as a loop end
+  /// hook of the application by the first sensor, so it runs after every loop iteration.
+  static void dispatch_frontend_states();
+  /// Number of states that never reached the frontends because a newer one was published in the same loop iteration.
+  static uint32_t get_coalesced_state_count() { return coalesced_state_count_; }
 
   /** This member variable stores the last state that has passed through all filters.
    *
@@ -148,8 +178,14 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   void internal_send_state_to_frontend(float state);
 
  protected:
-  CallbackManager<void(float)> raw_callback_;  ///< Storage for raw state callbacks.
-  CallbackManager<void(float)> callback_;      ///< Storage for filtered state callbacks.
+  CallbackManager<void(float)> raw_callback_;       ///< Storage for raw state callbacks.
+  CallbackManager<void(float)> callback_;           ///< Storage for filtered state callbacks.
+  CallbackManager<void(float)> frontend_callback_;  ///< Storage for frontend state callbacks.
+
+  static std::vector<Sensor *> dirty_sensors_;  ///< Sensors whose state has not been dispatched to the frontends yet
+  /// Sensors being dispatched, swapped with dirty_sensors_ so that both keep their capacity
+  static std::vector<Sensor *> dispatching_sensors_;
+  static uint32_t coalesced_state_count_;
 
   Filter *filter_list_{nullptr};  ///< Store all active filters.
 
@@ -157,6 +193,7 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   optional<StateClass> state_class_{STATE_CLASS_NONE};  ///< State class override
   bool force_update_{false};                            ///< Force update mode
   bool has_state_{false};
+  bool dirty_{false};  ///< In dirty_sensors_
 };
 
 }  // namespace sensor
@@ -0,0 +1,36 @@
+#include "window_statistics.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace sensor {
+
+void SortedWindow::set_window_size(size_t window_size) {
+  this->values_.init(window_size);
+  this->sorted_.clear();
+  this->sorted_.reserve(window_size);
+}
+
+void SortedWindow::push(float value) {
+  if (this->values_.capacity() == 0)
+    return;
+
+  if (this->values_.full()) {
+    float oldest = this->values_.front();
+    if (!std::isnan(oldest)) {
+      // Among equal values, remove the exact one so that 0.0 and -0.0 don't get mixed up
+      auto it = std::lower_bound(this->sorted_.begin(), this->sorted_.end(), oldest);
+      while (std::signbit(*it) != std::signbit(oldest) && std::next(it) != this->sorted_.end() &&
+             *std::next(it) == oldest)
+        ++it;
+      this->sorted_.erase(it);
+    }
+  }
+  this->values_.push_back(value);
+
+  if (!std::isnan(value))
+    this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+}
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "esphome/core/circular_buffer.h"
+
+namespace esphome {
+namespace sensor {
+
+/** Sliding window of values that keeps its non-NaN values sorted, for order statistics like the median.
+ *
+ * Every new value is inserted at its sorted position and the value dropping out of the window is removed again,
+ * both found with a binary search. Compared to sorting a copy of the window for every result, this needs no
+ * allocations after construction and only moves memory, which is cheap even for windows of a few hundred values.
+ *
+ * NaN values take up space in the window but are left out of the statistics.
+ */
+class SortedWindow {
+ public:
+  explicit SortedWindow(size_t window_size) { this->set_window_size(window_size); }
+
+  /// Change the window size, this drops all values in the window.
+  void set_window_size(size_t window_size);
+  /// Add a value, dropping the oldest one if the window is full.
+  void push(float value);
+
+  /// Number of non-NaN values in the window.
+  size_t size() const { return this->sorted_.size(); }
+  bool empty() const { return this->sorted_.empty(); }
+  /// The `index`-th smallest non-NaN value in the window.
+  float get(size_t index) const { return this->sorted_[index]; }
+  /// Number of bytes of heap memory reserved for the window.
+  size_t memory_usage() const { return this->values_.memory_usage() + this->sorted_.capacity() * sizeof(float); }
+
+ protected:
+  CircularBuffer<float> values_;  ///< All values in the window, in arrival order
+  std::vector<float> sorted_;     ///< The non-NaN values of the window in ascending order
+};
+
+/** Minimum or maximum of a sliding window, in amortized O(1) per value.
+ *
+ * Only keeps the values that can still become the extremum: a value that is worse than a newer one never can, since
+ * the newer one stays in the window longer. The kept values are therefore ordered, and the extremum is the oldest.
+ *
+ * NaN values take up space in the window but are left out.
+ *
+ * @tparam Compare std::less<float> for the minimum, std::greater<float> for the maximum.
+ */
+template<typename Compare> class ExtremumWindow {
+ public:
+  explicit ExtremumWindow(size_t window_size) { this->set_window_size(window_size); }
+
+  /// Change the window size, this drops all values in the window.
+  void set_window_size(size_t window_size) {
+    this->window_size_ = window_size;
+    this->entries_.init(window_size);
+  }
+
+  /// Add a value, dropping the oldest one if the window is full.
+  void push(float value) {
+    if (this->window_size_ == 0)
+      return;
+    const uint32_t index = this->next_index_++;
+    // The current extremum left the window
+    while (!this->entries_.empty() && index - this->entries_.front().index >= this->window_size_)
+      this->entries_.pop_front();
+    if (std::isnan(value))
+      return;
+    while (!this->entries_.empty() && !Compare()(this->entries_.back().value, value))
+      this->entries_.pop_back();
+    this->entries_.push_back(Entry{value, index});
+  }
+
+  /// The extremum of the non-NaN values in the window, NaN if there are none.
+  float get() const { return this->entries_.empty() ? NAN : this->entries_.front().value; }
+  /// Number of bytes of heap memory reserved for the window.
+  size_t memory_usage() const { return this->entries_.memory_usage(); }
+
+ protected:
+  struct Entry {
+    float value;
+    uint32_t index;  ///< Position in the stream of values, to know when it leaves the window
+  };
+
+  CircularBuffer<Entry> entries_;  ///< Every kept value is in the window, so this never overflows
+  size_t window_size_{0};
+  uint32_t next_index_{0};
+};
+
+}  // namespace sensor
+}  // namespace esphome
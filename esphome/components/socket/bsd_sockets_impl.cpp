@@ -54,6 +54,9 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_TICKLESS_LOOP
+    set_wake_loop_on_readable(this, false);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -125,6 +128,8 @@ class BSDSocketImpl : public Socket {
     return 0;
   }
 
+  int get_fd() const override { return this->fd_; }
+
  protected:
   int fd_;
   bool closed_ = false;
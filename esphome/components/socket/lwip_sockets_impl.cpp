@@ -47,6 +47,9 @@ class LwIPSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return lwip_bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_TICKLESS_LOOP
+    set_wake_loop_on_readable(this, false);
+#endif
     int ret = lwip_close(fd_);
     closed_ = true;
     return ret;
@@ -97,6 +100,8 @@ class LwIPSocketImpl : public Socket {
     return 0;
   }
 
+  int get_fd() const override { return this->fd_; }
+
  protected:
   int fd_;
   bool closed_ = false;
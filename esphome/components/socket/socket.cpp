@@ -5,6 +5,16 @@
 #include <string>
 #include "esphome/core/log.h"
 
+#ifdef USE_TICKLESS_LOOP
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <lwip/sockets.h>
+#include <algorithm>
+#include <vector>
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#endif
+
 namespace esphome {
 namespace socket {
 
@@ -73,6 +83,51 @@ socklen_t set_sockaddr_any(struct sockaddr *addr, socklen_t addrlen, uint16_t po
   return sizeof(sockaddr_in);
 #endif /* USE_NETWORK_IPV6 */
 }
+
+#ifdef USE_TICKLESS_LOOP
+// The tickless loop is only available on ESP32, whose sockets all come from lwIP
+static std::vector<int> wake_fds;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static Mutex wake_fds_mutex;                     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static TaskHandle_t wake_task_handle = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void wake_task(void *params) {
+  while (true) {
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    int max_fd = -1;
+    {
+      LockGuard guard{wake_fds_mutex};
+      for (int fd : wake_fds) {
+        FD_SET(fd, &read_fds);
+        max_fd = std::max(max_fd, fd);
+      }
+    }
+    // Sockets added meanwhile are only watched from the next round, which is at most as long as the loop sleeps
+    struct timeval timeout = {1, 0};
+    if (lwip_select(max_fd + 1, &read_fds, nullptr, nullptr, &timeout) != 0) {
+      // Readable or closed. The socket stays readable until the main loop has read it, so give it a tick to do so.
+      App.wake_loop_any_context();
+      vTaskDelay(1);
+    }
+  }
+}
+
+void set_wake_loop_on_readable(Socket *sock, bool wake) {
+  int fd = sock->get_fd();
+  if (fd < 0)
+    return;
+  LockGuard guard{wake_fds_mutex};
+  auto it = std::find(wake_fds.begin(), wake_fds.end(), fd);
+  if (wake && it == wake_fds.end()) {
+    wake_fds.push_back(fd);
+  } else if (!wake && it != wake_fds.end()) {
+    wake_fds.erase(it);
+  }
+  if (wake && wake_task_handle == nullptr)
+    xTaskCreate(wake_task, "socket_wake", 2048, nullptr, 1, &wake_task_handle);
+}
+#endif
+
 }  // namespace socket
 }  // namespace esphome
 #endif
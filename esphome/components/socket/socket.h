@@ -42,6 +42,9 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /// The file descriptor of the socket, -1 for implementations that don't have one.
+  virtual int get_fd() const { return -1; }
 };
 
 /// Create a socket of the given domain, type and protocol.
@@ -56,6 +59,15 @@ socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::stri
 /// Set a sockaddr to the any address and specified port for the IP version used by socket_ip().
 socklen_t set_sockaddr_any(struct sockaddr *addr, socklen_t addrlen, uint16_t port);
 
+#ifdef USE_TICKLESS_LOOP
+/** Wake the tickless main loop when `sock` has data to read or a connection to accept.
+ *
+ * A task waits for these sockets with select(), so that the components owning them can report their loop idle while
+ * waiting for the network. Sockets are removed again when they are closed. Must be called from the main loop task.
+ */
+void set_wake_loop_on_readable(Socket *sock, bool wake);
+#endif
+
 }  // namespace socket
 }  // namespace esphome
 #endif
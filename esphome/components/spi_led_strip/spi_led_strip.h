@@ -75,6 +75,18 @@ class SpiLedStrip : public light::AddressableLight,
       this->effect_data_[i] = 0;
   }
 
+  PixelBuffer get_pixel_buffer() const override {
+    PixelBuffer buffer;
+    // Every pixel is a brightness byte followed by blue, green and red, after the start frame
+    buffer.data = this->buf_ + 4;
+    buffer.effect_data = this->effect_data_;
+    buffer.stride = 4;
+    buffer.red = 3;
+    buffer.green = 2;
+    buffer.blue = 1;
+    return buffer;
+  }
+
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {
     size_t pos = index * 4 + 5;
@@ -0,0 +1,106 @@
+#include "power_analyzer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace voltage_sampler {
+
+void PowerAnalyzer::add(const float *current, size_t count) {
+  if (count == 0)
+    return;
+  if (!this->has_offsets_) {
+    this->current_offset_ = current[0];
+    this->has_offsets_ = true;
+  }
+  const float offset = this->current_offset_;
+  float sum = 0.0f;
+  float squared_sum = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    const float value = current[i] - offset;
+    sum += value;
+    squared_sum += value * value;
+  }
+  this->current_sum_ += sum;
+  this->current_squared_sum_ += squared_sum;
+  this->count_ += count;
+}
+
+void PowerAnalyzer::add(const float *current, const float *voltage, size_t count) {
+  if (count == 0)
+    return;
+  if (!this->has_offsets_) {
+    this->current_offset_ = current[0];
+    this->voltage_offset_ = voltage[0];
+    this->has_offsets_ = true;
+  }
+  const float current_offset = this->current_offset_;
+  const float voltage_offset = this->voltage_offset_;
+  float current_sum = 0.0f;
+  float current_squared_sum = 0.0f;
+  float voltage_sum = 0.0f;
+  float voltage_squared_sum = 0.0f;
+  float product_sum = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    const float i_value = current[i] - current_offset;
+    const float v_value = voltage[i] - voltage_offset;
+    current_sum += i_value;
+    current_squared_sum += i_value * i_value;
+    voltage_sum += v_value;
+    voltage_squared_sum += v_value * v_value;
+    product_sum += i_value * v_value;
+  }
+  this->current_sum_ += current_sum;
+  this->current_squared_sum_ += current_squared_sum;
+  this->voltage_sum_ += voltage_sum;
+  this->voltage_squared_sum_ += voltage_squared_sum;
+  this->product_sum_ += product_sum;
+  this->count_ += count;
+  this->has_voltage_ = true;
+}
+
+PowerMeasurement PowerAnalyzer::finish() {
+  PowerMeasurement result{};
+  result.samples = this->count_;
+  result.current_offset = NAN;
+  result.voltage_offset = NAN;
+  result.current_rms = NAN;
+  result.voltage_rms = NAN;
+  result.real_power = NAN;
+  result.apparent_power = NAN;
+  result.power_factor = NAN;
+
+  if (this->count_ != 0) {
+    const double n = this->count_;
+    // Means of the deviations from the offsets, which are the DC parts relative to those offsets
+    const double current_mean = this->current_sum_ / n;
+    const double current_variance = this->current_squared_sum_ / n - current_mean * current_mean;
+    result.current_offset = this->current_offset_ + current_mean;
+    result.current_rms = current_variance > 0.0 ? std::sqrt(current_variance) : 0.0;
+    // Track the DC part for the next window
+    this->current_offset_ = result.current_offset;
+
+    if (this->has_voltage_) {
+      const double voltage_mean = this->voltage_sum_ / n;
+      const double voltage_variance = this->voltage_squared_sum_ / n - voltage_mean * voltage_mean;
+      result.voltage_offset = this->voltage_offset_ + voltage_mean;
+      result.voltage_rms = voltage_variance > 0.0 ? std::sqrt(voltage_variance) : 0.0;
+      result.real_power = this->product_sum_ / n - current_mean * voltage_mean;
+      result.apparent_power = result.current_rms * result.voltage_rms;
+      if (result.apparent_power > 0.0f)
+        result.power_factor = std::max(-1.0f, std::min(1.0f, result.real_power / result.apparent_power));
+      this->voltage_offset_ = result.voltage_offset;
+    }
+  }
+
+  this->count_ = 0;
+  this->has_voltage_ = false;
+  this->current_sum_ = 0.0;
+  this->current_squared_sum_ = 0.0;
+  this->voltage_sum_ = 0.0;
+  this->voltage_squared_sum_ = 0.0;
+  this->product_sum_ = 0.0;
+  return result;
+}
+
+}  // namespace voltage_sampler
+}  // namespace esphome
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace voltage_sampler {
+
+/// The result of a PowerAnalyzer window, in the units of the samples (usually V at the ADC pins).
+struct PowerMeasurement {
+  uint32_t samples;
+  float current_offset;  ///< DC part of the current samples
+  float voltage_offset;  ///< DC part of the voltage samples, NaN without voltage
+  float current_rms;     ///< RMS of the AC part of the current
+  float voltage_rms;     ///< RMS of the AC part of the voltage, NaN without voltage
+  float real_power;      ///< Mean of the product of the AC parts, NaN without voltage
+  float apparent_power;  ///< Product of the RMS values, NaN without voltage
+  float power_factor;    ///< Real power over apparent power, NaN without voltage or when there is no apparent power
+};
+
+/** Streaming RMS and power computation over windows of current and optionally voltage samples.
+ *
+ * Samples are added in blocks as they arrive, so a window can span many loop iterations without blocking any of them,
+ * and finish() turns the window into a PowerMeasurement. The DC part (the bias of a current clamp circuit, for
+ * example) is removed from each window by computing the RMS values and the power over the deviations from the
+ * window mean. The sums are kept relative to the offset of the previous window, which tracks the DC part, so that they
+ * stay small and single precision sums per block lose little precision. Only the block sums go into double precision
+ * totals.
+ */
+class PowerAnalyzer {
+ public:
+  /// Add a block of current samples, for a current-only measurement.
+  void add(const float *current, size_t count);
+  /// Add a block of current samples with the voltage samples taken at the same time. Don't mix with the current-only
+  /// add() in one window.
+  void add(const float *current, const float *voltage, size_t count);
+
+  /// Number of samples in the current window.
+  uint32_t count() const { return this->count_; }
+  /// Compute the measurement of the current window and start a new one.
+  PowerMeasurement finish();
+
+ protected:
+  uint32_t count_{0};
+  bool has_voltage_{false};  ///< The current window has voltage samples
+  bool has_offsets_{false};  ///< current_offset_ and voltage_offset_ are set
+  float current_offset_{0.0f};
+  float voltage_offset_{0.0f};
+  double current_sum_{0.0};
+  double current_squared_sum_{0.0};
+  double voltage_sum_{0.0};
+  double voltage_squared_sum_{0.0};
+  double product_sum_{0.0};
+};
+
+}  // namespace voltage_sampler
+}  // namespace esphome
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace voltage_sampler {
@@ -10,6 +11,20 @@ class VoltageSampler {
  public:
   /// Get a voltage reading, in V.
   virtual float sample() = 0;
+
+  /** Whether this sampler measures continuously and passes the samples to the sample callbacks.
+   *
+   * Consumers that need many samples, like an RMS over a few mains periods, should then use the callbacks instead of
+   * polling sample() from the loop.
+   */
+  virtual bool is_continuous() const { return false; }
+  /// Add a callback for the blocks of samples, in V, of a continuous sampler.
+  void add_on_samples_callback(InlineFunction<void(const float *, size_t)> &&callback) {
+    this->samples_callback_.add(std::move(callback));
+  }
+
+ protected:
+  CallbackManager<void(const float *, size_t)> samples_callback_;
 };
 
 }  // namespace voltage_sampler
@@ -166,6 +166,8 @@ void WiFiComponent::loop() {
         } else {
           this->status_clear_warning();
           this->last_connected_ = now;
+          // Connection changes arrive as events, which wake the loop
+          this->report_loop_idle();
         }
         break;
       }
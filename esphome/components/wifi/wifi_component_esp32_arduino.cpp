@@ -622,6 +622,9 @@ void WiFiComponent::wifi_event_callback_(esphome_wifi_event_id_t event, esphome_
     default:
       break;
   }
+#ifdef USE_TICKLESS_LOOP
+  App.wake_loop_any_context();
+#endif
 }
 
 WiFiSTAConnectStatus WiFiComponent::wifi_sta_connect_status_() {
@@ -127,6 +127,9 @@ void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, voi
   if (xQueueSend(s_event_queue, &to_send, 0L) != pdPASS) {
     delete to_send;  // NOLINT(cppcoreguidelines-owning-memory)
   }
+#ifdef USE_TICKLESS_LOOP
+  App.wake_loop_any_context();
+#endif
 }
 
 void WiFiComponent::wifi_pre_setup_() {
@@ -32,6 +32,8 @@ WLEDLightEffect::WLEDLightEffect(const std::string &name) : AddressableLightEffe
 
 void WLEDLightEffect::start() {
   AddressableLightEffect::start();
+  this->payload_pending_ = false;
+  this->next_led_ = 0;
 
   if (this->blank_on_start_) {
     this->blank_at_ = 0;
@@ -67,18 +69,37 @@ void WLEDLightEffect::apply(light::AddressableLight &it, const Color &current_co
     }
   }
 
-  std::vector<uint8_t> payload;
-  while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+  while (true) {
+    if (!this->payload_pending_) {
+      uint16_t packet_size = udp_->parsePacket();
+      if (packet_size == 0) {
+        break;
+      }
+      this->payload_.resize(packet_size);
 
-    if (!udp_->read(&payload[0], payload.size())) {
-      continue;
+      if (!udp_->read(&this->payload_[0], this->payload_.size())) {
+        continue;
+      }
+    }
+    this->payload_pending_ = false;
+
+    if (this->starts_next_frame_(this->payload_)) {
+      // show what was received of the current frame first, this packet is applied after it has been written
+      this->next_led_ = 0;
+      this->payload_pending_ = true;
+      it.schedule_show();
+      break;
     }
 
-    if (!this->parse_frame_(it, &payload[0], payload.size())) {
-      ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", payload.size(), payload[0]);
+    if (!this->parse_frame_(it, &this->payload_[0], this->payload_.size())) {
+      ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", this->payload_.size(), this->payload_[0]);
       continue;
     }
+
+    // once a frame is complete, the packets of the next one must wait until it has been written
+    if (this->payload_[0] == DNRGB && this->next_led_ == 0) {
+      break;
+    }
   }
 
   // FIXME: Use roll-over safe arithmetic
@@ -149,10 +170,25 @@ bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *p
     blank_at_ = millis() + DEFAULT_BLANK_TIME;
   }
 
+  // a frame split over several DNRGB packets is shown once it reaches the last LED
+  if (protocol != DNRGB) {
+    this->next_led_ = 0;
+  } else if (this->next_led_ != 0) {
+    return true;
+  }
+
   it.schedule_show();
   return true;
 }
 
+bool WLEDLightEffect::starts_next_frame_(const std::vector<uint8_t> &payload) const {
+  // protocol, timeout, offset (2 bytes)
+  if (this->next_led_ == 0 || payload.size() < 4 || payload[0] != DNRGB) {
+    return false;
+  }
+  return encode_uint16(payload[2], payload[3]) < this->next_led_;
+}
+
 bool WLEDLightEffect::parse_notifier_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
   // Receive at least RGBW and Brightness for all LEDs from WLED Sync Notification
   // https://kno.wled.ge/interfaces/udp-notifier/
@@ -278,6 +314,7 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     }
   }
 
+  this->next_led_ = led < max_leds ? led : 0;
   return true;
 }
 
@@ -32,9 +32,14 @@ class WLEDLightEffect : public light::AddressableLightEffect {
   bool parse_drgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
   bool parse_drgbw_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
   bool parse_dnrgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
+  /// Whether `payload` is a DNRGB packet that starts a new frame before the current one reached the end of the LEDs.
+  bool starts_next_frame_(const std::vector<uint8_t> &payload) const;
 
   uint16_t port_{0};
   std::unique_ptr<UDP> udp_;
+  std::vector<uint8_t> payload_;
+  bool payload_pending_{false};  ///< payload_ has been received, but not applied yet
+  uint16_t next_led_{0};         ///< First LED not yet set in the DNRGB frame being assembled, 0 if there is none
   uint32_t blank_at_{0};
   uint32_t dropped_{0};
   uint8_t sync_group_mask_{0};
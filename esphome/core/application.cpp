@@ -2,6 +2,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include <algorithm>
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
@@ -11,6 +12,11 @@ namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_TICKLESS_LOOP
+// Upper bound for sleeping without any scheduled work, keeps the task watchdog fed
+static const uint32_t TICKLESS_MAX_SLEEP = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -62,13 +68,23 @@ void Application::setup() {
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+#if defined(USE_TICKLESS_LOOP) && defined(USE_ESP32)
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+#endif
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
+
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+#ifdef USE_TICKLESS_LOOP
+  bool loop_idle = true;
+#endif
+  for (uint16_t i = 0; i < this->looping_components_active_end_;) {
+    Component *component = this->looping_components_[i];
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -76,13 +92,32 @@ void Application::loop() {
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
+    // A component disabling its loop swaps a component that has not run yet into its slot
+    if (this->looping_components_[i] == component) {
+#ifdef USE_TICKLESS_LOOP
+      loop_idle &= component->loop_idle_;
+#endif
+      i++;
+    }
   }
+  for (auto *hook : this->loop_end_hooks_)
+    hook();
+  // Disabled components still report their status LED bits
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++)
+    new_app_state |= this->looping_components_[i]->get_component_state();
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
 
   auto elapsed = now - this->last_loop_;
-  if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
+#ifdef USE_TICKLESS_LOOP
+  if (loop_idle && !this->has_pending_enable_loop_requests_ && !HighFrequencyLoopRequester::is_high_frequency() &&
+      this->dump_config_at_ >= this->components_.size()) {
+    // Every component reported that it has nothing to do, so only the scheduler or a wake event can create new work
+    this->sleep_(std::min(this->scheduler.next_schedule_in().value_or(TICKLESS_MAX_SLEEP), TICKLESS_MAX_SLEEP));
+  } else
+#endif
+      if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_ - elapsed;
@@ -91,7 +126,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->sleep_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -148,6 +183,69 @@ void Application::calculate_looping_components_() {
     if (obj->has_overridden_loop())
       this->looping_components_.push_back(obj);
   }
+  // Components that already disabled their loop during setup() start out inactive
+  auto inactive = std::stable_partition(this->looping_components_.begin(), this->looping_components_.end(),
+                                        [](const Component *component) {
+                                          return (component->get_component_state() & COMPONENT_STATE_MASK) !=
+                                                 COMPONENT_STATE_LOOP_DONE;
+                                        });
+  this->looping_components_active_end_ = inactive - this->looping_components_.begin();
+}
+
+void Application::disable_component_loop_(Component *component) {
+  for (uint16_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    this->looping_components_active_end_--;
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    return;
+  }
+}
+
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+
+void Application::enable_pending_loops_() {
+  this->has_pending_enable_loop_requests_ = false;
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    // enable_loop() swaps the component to the end of the active range, which might be index i itself
+    component->enable_loop();
+  }
+}
+
+void Application::sleep_(uint32_t delay_ms) {
+#if defined(USE_TICKLESS_LOOP) && defined(USE_ESP32)
+  // Returns early when wake_loop_any_context() notified the loop task
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(delay_ms));
+#else
+  delay(delay_ms);
+#endif
+}
+
+void IRAM_ATTR Application::wake_loop_any_context() {
+#if defined(USE_TICKLESS_LOOP) && defined(USE_ESP32)
+  if (this->loop_task_handle_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->loop_task_handle_, &higher_priority_task_woken);
+    if (higher_priority_task_woken)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(this->loop_task_handle_);
+  }
+#endif
 }
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -9,6 +9,11 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#if defined(USE_TICKLESS_LOOP) && defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -233,6 +238,20 @@ class Application {
 
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
+  /// Register a function that is called at the end of every loop iteration, after all components ran.
+  void add_loop_end_hook(void (*hook)()) { this->loop_end_hooks_.push_back(hook); }
+
+  const std::vector<Component *> &get_components() { return this->components_; }
+
+  /** Wake the main loop up if it is sleeping. Safe to call from any task and from interrupts.
+   *
+   * Only has an effect with `tickless_loop` enabled, where the loop sleeps until the next scheduled timeout once all
+   * components reported their loop() idle, see Component::report_loop_idle(). Wake sources like GPIO interrupts,
+   * event handlers or UART receive handlers call this to get their component serviced right away. Sockets do so with
+   * socket::set_wake_loop_on_readable().
+   */
+  void wake_loop_any_context();
+
   void feed_wdt();
 
   void reboot();
@@ -467,11 +486,22 @@ class Application {
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
+  void enable_pending_loops_();
+  void sleep_(uint32_t delay_ms);
 
   void feed_wdt_arch_();
 
   std::vector<Component *> components_{};
+  /// Components overriding loop(): [0, looping_components_active_end_) are called, the rest has disabled its loop.
   std::vector<Component *> looping_components_{};
+  uint16_t looping_components_active_end_{0};
+  volatile bool has_pending_enable_loop_requests_{false};
+  std::vector<void (*)()> loop_end_hooks_{};
+#if defined(USE_TICKLESS_LOOP) && defined(USE_ESP32)
+  TaskHandle_t loop_task_handle_{nullptr};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
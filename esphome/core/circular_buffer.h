@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace esphome {
+
+/** Fixed-capacity FIFO buffer that overwrites its oldest element when full.
+ *
+ * All storage is allocated once by init() (or the constructor), so unlike std::deque, which allocates and frees chunks
+ * as elements move through it, pushing and popping never touch the heap. This makes it suited for sliding windows that
+ * live for the whole runtime, like the windows of sensor filters.
+ *
+ * Elements are indexed from the oldest (0, front()) to the newest (size() - 1, back()).
+ */
+template<typename T> class CircularBuffer {
+ public:
+  CircularBuffer() = default;
+  explicit CircularBuffer(size_t capacity) { this->init(capacity); }
+
+  /// Allocate storage for `capacity` elements, dropping all current elements.
+  void init(size_t capacity) {
+    if (capacity != this->capacity_) {
+      this->data_.reset(capacity == 0 ? nullptr : new T[capacity]);  // NOLINT(cppcoreguidelines-owning-memory)
+      this->capacity_ = capacity;
+    }
+    this->clear();
+  }
+
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+  /// Number of bytes of heap memory used for the elements.
+  size_t memory_usage() const { return this->capacity_ * sizeof(T); }
+
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  /// Append an element, overwriting the oldest one if the buffer is full. Does nothing for a capacity of 0.
+  void push_back(const T &value) {
+    if (this->capacity_ == 0)
+      return;
+    if (this->full()) {
+      this->data_[this->head_] = value;
+      this->head_ = this->wrap_(this->head_ + 1);
+    } else {
+      this->data_[this->wrap_(this->head_ + this->size_)] = value;
+      this->size_++;
+    }
+  }
+  /// Remove the oldest element, the buffer must not be empty.
+  void pop_front() {
+    this->head_ = this->wrap_(this->head_ + 1);
+    this->size_--;
+  }
+  /// Remove the newest element, the buffer must not be empty.
+  void pop_back() { this->size_--; }
+
+  T &front() { return this->data_[this->head_]; }
+  const T &front() const { return this->data_[this->head_]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+  const T &back() const { return (*this)[this->size_ - 1]; }
+  T &operator[](size_t index) { return this->data_[this->wrap_(this->head_ + index)]; }
+  const T &operator[](size_t index) const { return this->data_[this->wrap_(this->head_ + index)]; }
+
+ protected:
+  /// Map a position of at most twice the capacity into the storage, cheaper than a modulo.
+  size_t wrap_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+
+  std::unique_ptr<T[]> data_;
+  size_t capacity_{0};
+  size_t head_{0};  ///< Position of the oldest element in data_
+  size_t size_{0};
+};
+
+}  // namespace esphome
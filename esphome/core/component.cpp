@@ -34,6 +34,7 @@ const uint32_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint32_t COMPONENT_STATE_SETUP = 0x01;
 const uint32_t COMPONENT_STATE_LOOP = 0x02;
 const uint32_t COMPONENT_STATE_FAILED = 0x03;
+const uint32_t COMPONENT_STATE_LOOP_DONE = 0x04;
 const uint32_t STATUS_LED_MASK = 0xFF00;
 const uint32_t STATUS_LED_OK = 0x0000;
 const uint32_t STATUS_LED_WARNING = 0x0100;
@@ -49,7 +50,7 @@ void Component::setup() {}
 
 void Component::loop() {}
 
-void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+void Component::set_interval(const std::string &name, uint32_t interval, SchedulerCallback &&f) {  // NOLINT
   App.scheduler.set_interval(this, name, interval, std::move(f));
 }
 
@@ -66,7 +67,7 @@ bool Component::cancel_retry(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_retry(this, name);
 }
 
-void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+void Component::set_timeout(const std::string &name, uint32_t timeout, SchedulerCallback &&f) {  // NOLINT
   return App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
@@ -74,6 +75,31 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+void Component::set_interval(uint32_t id, uint32_t interval, SchedulerCallback &&f) {  // NOLINT
+  App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+
+void Component::set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                          std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
+  App.scheduler.set_retry(this, id, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+}
+
+bool Component::cancel_retry(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_retry(this, id);
+}
+
+void Component::set_timeout(uint32_t id, uint32_t timeout, SchedulerCallback &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() {
@@ -91,7 +117,15 @@ void Component::call() {
       // State Construction: Call setup and set state to setup
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_SETUP;
+#ifdef USE_LOOP_PROFILER
+      {
+        uint32_t started = micros();
+        this->call_setup();
+        this->get_or_create_profile().setup_us = micros() - started;
+      }
+#else
       this->call_setup();
+#endif
       break;
     case COMPONENT_STATE_SETUP:
       // State setup: Call first loop and set state to loop
@@ -101,10 +135,19 @@ void Component::call() {
       break;
     case COMPONENT_STATE_LOOP:
       // State loop: Call loop
+#ifdef USE_TICKLESS_LOOP
+      this->loop_idle_ = false;
+#endif
       this->call_loop();
       break;
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
+#ifdef USE_TICKLESS_LOOP
+      this->loop_idle_ = true;
+#endif
+      break;
+    case COMPONENT_STATE_LOOP_DONE:  // NOLINT(bugprone-branch-clone)
+      // State loop done: Do nothing, loop() was disabled by the component
       break;
     default:
       break;
@@ -121,30 +164,64 @@ void Component::mark_failed() {
   this->component_state_ |= COMPONENT_STATE_FAILED;
   this->status_set_error();
 }
-void Component::defer(std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", 0, std::move(f));
+void Component::defer(SchedulerCallback &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, Scheduler::NO_ID, 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
-void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
+void Component::defer(const std::string &name, SchedulerCallback &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
-void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+void Component::set_timeout(uint32_t timeout, SchedulerCallback &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, Scheduler::NO_ID, timeout, std::move(f));
 }
-void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+void Component::set_interval(uint32_t interval, SchedulerCallback &&f) {  // NOLINT
+  App.scheduler.set_interval(this, Scheduler::NO_ID, interval, std::move(f));
 }
 void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,
                           float backoff_increase_factor) {  // NOLINT
-  App.scheduler.set_retry(this, "", initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+  App.scheduler.set_retry(this, Scheduler::NO_ID, initial_wait_time, max_attempts, std::move(f),
+                          backoff_increase_factor);
 }
 bool Component::is_failed() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() const {
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
+         (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
+void Component::disable_loop() {
+  uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  if (state != COMPONENT_STATE_SETUP && state != COMPONENT_STATE_LOOP)
+    return;
+  ESP_LOGVV(TAG, "Component %s loop disabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP_DONE;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  if ((this->component_state_ & COMPONENT_STATE_MASK) != COMPONENT_STATE_LOOP_DONE)
+    return;
+  ESP_LOGVV(TAG, "Component %s loop enabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP;
+  App.enable_component_loop_(this);
+}
+void IRAM_ATTR Component::enable_loop_soon_any_context() {
+  // Only flags are touched here, Application::loop() does the actual work on the main loop task
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+#ifdef USE_TICKLESS_LOOP
+  App.wake_loop_any_context();
+#endif
+}
+#ifdef USE_LOOP_PROFILER
+ComponentProfile &Component::get_or_create_profile() {
+  if (!this->profile_)
+    this->profile_ = make_unique<ComponentProfile>();
+  return *this->profile_;
+}
+#endif
 bool Component::can_proceed() { return true; }
 bool Component::status_has_warning() const { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() const { return this->component_state_ & STATUS_LED_ERROR; }
@@ -215,22 +292,40 @@ void PollingComponent::call_setup() {
   this->start_poller();
 }
 
+static constexpr uint32_t POLLING_UPDATE_ID = fnv1_hash("update");
+
 void PollingComponent::start_poller() {
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval(POLLING_UPDATE_ID, this->get_update_interval(), [this]() { this->update(); });
 }
 
 void PollingComponent::stop_poller() {
   // Clear the interval to suspend component
-  this->cancel_interval("update");
+  this->cancel_interval(POLLING_UPDATE_ID);
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
-    : started_(millis()), component_(component) {}
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, ExecutionSource source)
+    : started_(millis()), component_(component) {
+#ifdef USE_LOOP_PROFILER
+  this->source_ = source;
+  this->started_us_ = micros();
+#endif
+}
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_LOOP_PROFILER
+  if (this->component_ != nullptr) {
+    uint32_t duration_us = micros() - this->started_us_;
+    auto &profile = this->component_->get_or_create_profile();
+    if (this->source_ == ExecutionSource::SCHEDULER) {
+      profile.scheduler.record(duration_us);
+    } else {
+      profile.loop.record(duration_us);
+    }
+  }
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
@@ -3,8 +3,12 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 
+#include "esphome/core/defines.h"
+#include "esphome/core/inline_function.h"
+#include "esphome/core/loop_profiler.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -58,6 +62,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -65,6 +70,9 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum class RetryResult { DONE, RETRY };
 
+/// Callback type for timeouts/intervals/defers. Lambdas capturing up to four pointers worth of data stay off the heap.
+using SchedulerCallback = InlineFunction<void()>;
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -122,6 +130,40 @@ class Component {
 
   bool is_ready() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components whose loop() has nothing to do should call this, so that the main loop skips them entirely. Must be
+   * called from the main loop task.
+   */
+  void disable_loop();
+
+  /** Tell the main loop that this call of loop() found nothing to do. Only valid within loop().
+   *
+   * With `tickless_loop` enabled, the main loop sleeps until the next scheduled timeout or wake event once every
+   * active component has reported this in the same iteration. A component doing so has to wake the loop when new work
+   * arrives outside of loop(), with App.wake_loop_any_context() or enable_loop_soon_any_context().
+   */
+  void report_loop_idle() {
+#ifdef USE_TICKLESS_LOOP
+    this->loop_idle_ = true;
+#endif
+  }
+
+  /// Resume calling loop() after disable_loop(). Must be called from the main loop task.
+  void enable_loop();
+
+  /** Resume calling loop() after disable_loop(), from any task or an interrupt.
+   *
+   * The loop is re-enabled at the start of the next main loop iteration, which is woken up if it is sleeping.
+   */
+  void enable_loop_soon_any_context();
+
+#ifdef USE_LOOP_PROFILER
+  /// Execution times of this component, nullptr if it has not run any code yet.
+  const ComponentProfile *get_profile() const { return this->profile_.get(); }
+  ComponentProfile &get_or_create_profile();
+#endif
+
   virtual bool can_proceed();
 
   bool status_has_warning() const;
@@ -175,9 +217,20 @@ class Component {
    *
    * @see cancel_interval()
    */
-  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+  void set_interval(const std::string &name, uint32_t interval, SchedulerCallback &&f);  // NOLINT
+
+  void set_interval(uint32_t interval, SchedulerCallback &&f);  // NOLINT
 
-  void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
+  /** Set an interval function identified by a numeric id instead of a name.
+   *
+   * Ids share their namespace with names: `fnv1_hash("name")` refers to the same interval as `"name"`. Passing a
+   * compile-time hashed id avoids constructing a std::string on every call.
+   *
+   * @param id The identifier for this interval function, see Scheduler::name_to_id().
+   * @param interval The interval in ms.
+   * @param f The function (or lambda) that should be called
+   */
+  void set_interval(uint32_t id, uint32_t interval, SchedulerCallback &&f);  // NOLINT
 
   /** Cancel an interval function.
    *
@@ -185,6 +238,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(uint32_t id);               // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -222,12 +276,17 @@ class Component {
   void set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,  // NOLINT
                  float backoff_increase_factor = 1.0f);                                                      // NOLINT
 
+  /// Set a retry function identified by a numeric id, see set_interval(uint32_t, uint32_t, std::function).
+  void set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,                   // NOLINT
+                 std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor = 1.0f);  // NOLINT
+
   /** Cancel a retry function.
    *
    * @param name The identifier for this retry function.
    * @return Whether a retry function was deleted.
    */
   bool cancel_retry(const std::string &name);  // NOLINT
+  bool cancel_retry(uint32_t id);               // NOLINT
 
   /** Set a timeout function with a unique name.
    *
@@ -243,9 +302,12 @@ class Component {
    *
    * @see cancel_timeout()
    */
-  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+  void set_timeout(const std::string &name, uint32_t timeout, SchedulerCallback &&f);  // NOLINT
 
-  void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
+  void set_timeout(uint32_t timeout, SchedulerCallback &&f);  // NOLINT
+
+  /// Set a timeout function identified by a numeric id, see set_interval(uint32_t, uint32_t, std::function).
+  void set_timeout(uint32_t id, uint32_t timeout, SchedulerCallback &&f);  // NOLINT
 
   /** Cancel a timeout function.
    *
@@ -253,6 +315,7 @@ class Component {
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(uint32_t id);               // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -261,17 +324,24 @@ class Component {
    * @param name The name of the defer function.
    * @param f The callback.
    */
-  void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
+  void defer(const std::string &name, SchedulerCallback &&f);  // NOLINT
 
   /// Defer a callback to the next loop() call.
-  void defer(std::function<void()> &&f);  // NOLINT
+  void defer(SchedulerCallback &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
+  volatile bool pending_enable_loop_{false};  ///< Set by enable_loop_soon_any_context().
+#ifdef USE_TICKLESS_LOOP
+  bool loop_idle_{false};  ///< Set by report_loop_idle() during the last loop() call.
+#endif
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+#ifdef USE_LOOP_PROFILER
+  std::unique_ptr<ComponentProfile> profile_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -319,14 +389,24 @@ class PollingComponent : public Component {
   uint32_t update_interval_;
 };
 
+/// What a WarnIfComponentBlockingGuard is timing, used to file the duration when `loop_profiler` is enabled.
+enum class ExecutionSource : uint8_t {
+  LOOP,
+  SCHEDULER,
+};
+
 class WarnIfComponentBlockingGuard {
  public:
-  WarnIfComponentBlockingGuard(Component *component);
+  WarnIfComponentBlockingGuard(Component *component, ExecutionSource source = ExecutionSource::LOOP);
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_LOOP_PROFILER
+  uint32_t started_us_;
+  ExecutionSource source_;
+#endif
 };
 
 }  // namespace esphome
@@ -20,6 +20,8 @@ class ComponentIterator {
  public:
   void begin(bool include_internal = false);
   void advance();
+  /// Whether the iterator has gone through all entities since the last begin(), or was never started.
+  bool completed() const { return this->state_ == IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
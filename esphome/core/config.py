@@ -113,6 +113,16 @@ else:
 
 
 CONF_ESP8266_RESTORE_FROM_FLASH = "esp8266_restore_from_flash"
+CONF_SCHEDULER_BACKEND = "scheduler_backend"
+CONF_TICKLESS_LOOP = "tickless_loop"
+CONF_LOOP_PROFILER = "loop_profiler"
+
+SCHEDULER_BACKENDS = {
+    # binary heap, cancelled items are flagged and dropped once they reach the top
+    "heap": None,
+    # binary heap with per-item positions and a name index, O(log n) cancel
+    "indexed_heap": "USE_SCHEDULER_INDEXED_HEAP",
+}
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -167,11 +177,28 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_COMPILE_PROCESS_LIMIT, default=_compile_process_limit_default
             ): cv.int_range(min=1, max=multiprocessing.cpu_count()),
+            cv.Optional(CONF_SCHEDULER_BACKEND, default="heap"): cv.one_of(
+                *SCHEDULER_BACKENDS, lower=True
+            ),
+            cv.Optional(CONF_TICKLESS_LOOP, default=False): cv.boolean,
+            cv.Optional(CONF_LOOP_PROFILER, default=False): cv.boolean,
         }
     ),
     validate_hostname,
 )
 
+
+def _final_validate(config):
+    if config[CONF_TICKLESS_LOOP] and not CORE.is_esp32:
+        # Other platforms have no way for interrupts and other tasks to end the sleep
+        raise cv.Invalid(
+            f"{CONF_TICKLESS_LOOP} is only available on ESP32",
+            path=[CONF_TICKLESS_LOOP],
+        )
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
 PRELOAD_CONFIG_SCHEMA = cv.Schema(
     {
         cv.Required(CONF_NAME): cv.valid_name,
@@ -385,6 +412,13 @@ async def to_code(config):
     if CORE.using_arduino and not CORE.is_bk72xx:
         CORE.add_job(add_arduino_global_workaround)
 
+    if scheduler_define := SCHEDULER_BACKENDS[config[CONF_SCHEDULER_BACKEND]]:
+        cg.add_define(scheduler_define)
+    if config[CONF_TICKLESS_LOOP]:
+        cg.add_define("USE_TICKLESS_LOOP")
+    if config[CONF_LOOP_PROFILER]:
+        cg.add_define("USE_LOOP_PROFILER")
+
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
 
@@ -26,7 +26,7 @@ void Controller::setup_controller(bool include_internal) {
 #ifdef USE_SENSOR
   for (auto *obj : App.get_sensors()) {
     if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](float state) { this->on_sensor_update(obj, state); });
+      obj->add_on_frontend_state_callback([this, obj](float state) { this->on_sensor_update(obj, state); });
   }
 #endif
 #ifdef USE_SWITCH
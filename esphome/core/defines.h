@@ -98,12 +98,15 @@
 
 // ESP32-specific feature flags
 #ifdef USE_ESP32
+#define USE_ADC_CONTINUOUS
 #define USE_BLUETOOTH_PROXY
 #define USE_ESP32_BLE
 #define USE_ESP32_BLE_CLIENT
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_ASYNC
+#define USE_LOGGER_TOKENIZED
 #define USE_MICRO_WAKE_WORD_VAD
 #define USE_MICROPHONE
 #define USE_PSRAM
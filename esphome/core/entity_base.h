@@ -2,6 +2,7 @@
 
 #include <string>
 #include <cstdint>
+#include "esphome/core/defines.h"
 #include "string_ref.h"
 
 namespace esphome {
@@ -47,6 +48,12 @@ class EntityBase {
   std::string get_icon() const;
   void set_icon(const char *icon);
 
+#ifdef USE_API
+  // Get/set the API state generation of the last state change of this Entity
+  uint32_t get_state_generation() const { return this->state_generation_; }
+  void set_state_generation(uint32_t state_generation) { this->state_generation_ = state_generation; }
+#endif
+
  protected:
   /// The hash_base() function has been deprecated. It is kept in this
   /// class for now, to prevent external components from not compiling.
@@ -61,6 +68,9 @@ class EntityBase {
   bool internal_{false};
   bool disabled_by_default_{false};
   EntityCategory entity_category_{ENTITY_CATEGORY_NONE};
+#ifdef USE_API
+  uint32_t state_generation_{0};
+#endif
 };
 
 class EntityBase_DeviceClass {  // NOLINT(readability-identifier-naming)
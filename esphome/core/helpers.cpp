@@ -615,6 +615,17 @@ void hsv_to_rgb(int hue, float saturation, float value, float &red, float &green
   blue += delta;
 }
 
+// Utilities
+static CallbackStats callback_stats{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+CallbackStats get_callback_stats() { return callback_stats; }
+void internal::record_callback(bool is_inline) {
+  callback_stats.callbacks++;
+  if (!is_inline)
+    callback_stats.capture_allocations++;
+}
+void internal::record_callback_array() { callback_stats.array_allocations++; }
+
 // System APIs
 #if defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_HOST)
 // ESP8266 doesn't have mutexes, but that shouldn't be an issue as it's single-core and non-preemptive OS.
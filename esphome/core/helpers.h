@@ -8,6 +8,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "esphome/core/inline_function.h"
 #include "esphome/core/optional.h"
 
 #ifdef USE_ESP32
@@ -166,6 +167,11 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
 
+/// Calculate a FNV-1 hash of the null-terminated \p str, continuing from \p hash. Usable at compile time.
+constexpr uint32_t fnv1_hash(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == '\0' ? hash : fnv1_hash(str + 1, (hash * 16777619UL) ^ static_cast<uint32_t>(*str));
+}
+
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
 /// Return a random float between 0 and 1.
@@ -471,29 +477,69 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 /// @name Utilities
 /// @{
 
+/// Statistics of all CallbackManagers together, see get_callback_stats().
+struct CallbackStats {
+  /// Callbacks added to any CallbackManager.
+  uint32_t callbacks;
+  /// Callbacks whose captures did not fit inline and were moved to the heap.
+  uint32_t capture_allocations;
+  /// Arrays allocated by any CallbackManager to hold its callbacks.
+  uint32_t array_allocations;
+};
+CallbackStats get_callback_stats();
+
+namespace internal {
+void record_callback(bool is_inline);
+void record_callback_array();
+}  // namespace internal
+
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
+ *
+ * Callbacks are InlineFunctions, so captures of up to four pointers are stored without a heap allocation of their own,
+ * and they are kept in an array that doubles when full, starting at a single callback. The many entities with one or
+ * two callbacks waste no capacity, and a manager with n callbacks allocates about log2(n) times. Unlike std::vector,
+ * the size and capacity fit into the word of a single size_t.
+ *
+ * A callback must not add callbacks to the manager calling it.
  *
  * @tparam Ts The arguments for the callbacks, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
+  using Callback = InlineFunction<void(Ts...)>;
+
   /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void add(Callback &&callback) {
+    internal::record_callback(callback.is_inline());
+    if (this->size_ == this->capacity_) {
+      const uint16_t capacity = this->capacity_ == 0 ? 1 : this->capacity_ * 2;
+      internal::record_callback_array();
+      std::unique_ptr<Callback[]> callbacks(new Callback[capacity]);  // NOLINT(cppcoreguidelines-owning-memory)
+      for (size_t i = 0; i < this->size_; i++)
+        callbacks[i] = std::move(this->callbacks_[i]);
+      this->callbacks_ = std::move(callbacks);
+      this->capacity_ = capacity;
+    }
+    this->callbacks_[this->size_++] = std::move(callback);
+  }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
-    for (auto &cb : this->callbacks_)
-      cb(args...);
+    Callback *end = this->callbacks_.get() + this->size_;
+    for (Callback *callback = this->callbacks_.get(); callback != end; callback++)
+      (*callback)(args...);
   }
-  size_t size() const { return this->callbacks_.size(); }
+  size_t size() const { return this->size_; }
 
   /// Call all callbacks in this manager.
   void operator()(Ts... args) { call(args...); }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  std::unique_ptr<Callback[]> callbacks_;
+  uint16_t size_{0};
+  uint16_t capacity_{0};
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace esphome {
+
+template<typename Signature, size_t Capacity = 4 * sizeof(void *)> class InlineFunction;
+
+/** Move-only replacement for std::function that stores callables of up to `Capacity` bytes inside the object.
+ *
+ * std::function only avoids the heap for trivially copyable callables of at most two pointers, which excludes most
+ * lambdas capturing a few values. InlineFunction keeps any nothrow-movable callable that fits in `Capacity` inline,
+ * and only falls back to the heap ("spills") for larger ones. Whether that happened can be checked with is_inline().
+ */
+template<typename R, typename... Args, size_t Capacity> class InlineFunction<R(Args...), Capacity> {
+  // Not helpers.h's is_invocable, as helpers.h includes this file for CallbackManager
+  template<typename F, typename = void> struct IsCallable : std::false_type {};
+  template<typename F>
+  struct IsCallable<F, decltype(void(std::declval<F &>()(std::declval<Args>()...)))> : std::true_type {};
+
+ public:
+  InlineFunction() = default;
+  InlineFunction(std::nullptr_t) {}  // NOLINT(google-explicit-constructor)
+
+  template<typename F, typename D = typename std::decay<F>::type,
+           typename std::enable_if<!std::is_same<D, InlineFunction>::value && IsCallable<D>::value, int>::type = 0>
+  InlineFunction(F &&f) {  // NOLINT(google-explicit-constructor)
+    this->construct_(std::forward<F>(f), std::integral_constant<bool, fits_inline<D>()>{});
+  }
+
+  InlineFunction(InlineFunction &&other) noexcept { this->take_(other); }
+  InlineFunction &operator=(InlineFunction &&other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->take_(other);
+    }
+    return *this;
+  }
+  InlineFunction(const InlineFunction &) = delete;
+  InlineFunction &operator=(const InlineFunction &) = delete;
+  ~InlineFunction() { this->reset(); }
+
+  /// Destroy the stored callable, leaving this function empty.
+  void reset() {
+    if (this->manager_ != nullptr) {
+      this->manager_(Op::DESTROY, this->storage_, nullptr);
+      this->manager_ = nullptr;
+      this->invoker_ = nullptr;
+    }
+  }
+
+  explicit operator bool() const { return this->invoker_ != nullptr; }
+
+  /// Whether the stored callable lives inside this object (true for empty functions too).
+  bool is_inline() const {
+    return this->manager_ == nullptr || this->manager_(Op::IS_INLINE, nullptr, nullptr);
+  }
+
+  R operator()(Args... args) const {
+    return this->invoker_(const_cast<unsigned char *>(this->storage_), std::forward<Args>(args)...);
+  }
+
+  template<typename F> static constexpr bool fits_inline() {
+    return sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible<F>::value;
+  }
+
+ protected:
+  enum class Op { MOVE, DESTROY, IS_INLINE };
+  using Invoker = R (*)(void *, Args &&...);
+  using Manager = bool (*)(Op, void *, void *);
+
+  template<typename F> void construct_(F &&f, std::true_type /*inline*/) {
+    using D = typename std::decay<F>::type;
+    new (this->storage_) D(std::forward<F>(f));
+    this->invoker_ = &InlineFunction::invoke_inline_<D>;
+    this->manager_ = &InlineFunction::manage_inline_<D>;
+  }
+  template<typename F> void construct_(F &&f, std::false_type /*inline*/) {
+    using D = typename std::decay<F>::type;
+    new (this->storage_) D *(new D(std::forward<F>(f)));  // NOLINT(cppcoreguidelines-owning-memory)
+    this->invoker_ = &InlineFunction::invoke_heap_<D>;
+    this->manager_ = &InlineFunction::manage_heap_<D>;
+  }
+
+  void take_(InlineFunction &other) {
+    if (other.manager_ == nullptr)
+      return;
+    other.manager_(Op::MOVE, this->storage_, other.storage_);
+    this->invoker_ = other.invoker_;
+    this->manager_ = other.manager_;
+    other.invoker_ = nullptr;
+    other.manager_ = nullptr;
+  }
+
+  // static_cast<R> discards the result of callables returning a value when R is void, like std::function does
+  template<typename D> static R invoke_inline_(void *storage, Args &&...args) {
+    return static_cast<R>((*static_cast<D *>(storage))(std::forward<Args>(args)...));
+  }
+  template<typename D> static bool manage_inline_(Op op, void *dst, void *src) {
+    switch (op) {
+      case Op::MOVE:
+        new (dst) D(std::move(*static_cast<D *>(src)));
+        static_cast<D *>(src)->~D();
+        break;
+      case Op::DESTROY:
+        static_cast<D *>(dst)->~D();
+        break;
+      case Op::IS_INLINE:
+        return true;
+    }
+    return false;
+  }
+  template<typename D> static R invoke_heap_(void *storage, Args &&...args) {
+    return static_cast<R>((**static_cast<D **>(storage))(std::forward<Args>(args)...));
+  }
+  template<typename D> static bool manage_heap_(Op op, void *dst, void *src) {
+    switch (op) {
+      case Op::MOVE:
+        new (dst) D *(*static_cast<D **>(src));
+        break;
+      case Op::DESTROY:
+        delete *static_cast<D **>(dst);  // NOLINT(cppcoreguidelines-owning-memory)
+        break;
+      case Op::IS_INLINE:
+        return false;
+    }
+    return false;
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[Capacity < sizeof(void *) ? sizeof(void *) : Capacity];
+  Invoker invoker_{nullptr};
+  Manager manager_{nullptr};
+};
+
+}  // namespace esphome
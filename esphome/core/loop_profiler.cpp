@@ -0,0 +1,58 @@
+#include "esphome/core/loop_profiler.h"
+
+#ifdef USE_LOOP_PROFILER
+
+namespace esphome {
+
+// Upper bound of bucket 0 is 2^FIRST_BUCKET_BITS µs
+static const uint8_t FIRST_BUCKET_BITS = 5;
+
+void ExecutionHistogram::record(uint32_t duration_us) {
+  uint8_t index = 0;
+  if (duration_us >> FIRST_BUCKET_BITS) {
+    // number of significant bits, minus the bits covered by bucket 0
+    index = 32 - __builtin_clz(duration_us) - FIRST_BUCKET_BITS;
+    if (index >= BUCKET_COUNT)
+      index = BUCKET_COUNT - 1;
+  }
+  this->buckets_[index]++;
+  this->count_++;
+  this->total_us_ += duration_us;
+  if (duration_us < this->min_us_)
+    this->min_us_ = duration_us;
+  if (duration_us > this->max_us_)
+    this->max_us_ = duration_us;
+}
+
+uint32_t ExecutionHistogram::get_average_us() const {
+  if (this->count_ == 0)
+    return 0;
+  return this->total_us_ / this->count_;
+}
+
+uint32_t ExecutionHistogram::get_percentile_us(float percentile) const {
+  if (this->count_ == 0)
+    return 0;
+  uint32_t target = percentile * this->count_;
+  if (target == 0)
+    target = 1;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += this->buckets_[i];
+    if (seen >= target) {
+      uint32_t upper = get_bucket_upper_bound_us(i);
+      return upper < this->max_us_ ? upper : this->max_us_;
+    }
+  }
+  return this->max_us_;
+}
+
+uint32_t ExecutionHistogram::get_bucket_upper_bound_us(uint8_t index) {
+  if (index >= BUCKET_COUNT - 1)
+    return UINT32_MAX;
+  return 1UL << (index + FIRST_BUCKET_BITS);
+}
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOOP_PROFILER
+
+#include <cstdint>
+
+namespace esphome {
+
+/** Histogram of execution times with fixed, logarithmically spaced buckets.
+ *
+ * Bucket 0 counts durations below 32 µs, every following bucket doubles the upper bound, and the last bucket counts
+ * everything from about half a second up. Recording is O(1) and never allocates, so it is cheap enough to wrap every
+ * loop() and scheduler callback with.
+ */
+class ExecutionHistogram {
+ public:
+  static constexpr uint8_t BUCKET_COUNT = 16;
+
+  void record(uint32_t duration_us);
+
+  uint32_t get_count() const { return this->count_; }
+  uint64_t get_total_us() const { return this->total_us_; }
+  uint32_t get_min_us() const { return this->count_ == 0 ? 0 : this->min_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+  uint32_t get_average_us() const;
+  /** Estimate a percentile from the buckets.
+   *
+   * @param percentile The percentile in the range [0, 1], for example 0.99.
+   * @return The upper bound of the bucket the percentile falls in, limited to the maximum recorded duration.
+   */
+  uint32_t get_percentile_us(float percentile) const;
+  uint32_t get_bucket(uint8_t index) const { return this->buckets_[index]; }
+
+  /// Exclusive upper bound of the given bucket in microseconds, UINT32_MAX for the last bucket.
+  static uint32_t get_bucket_upper_bound_us(uint8_t index);
+
+ protected:
+  uint32_t buckets_[BUCKET_COUNT]{};
+  uint32_t count_{0};
+  uint32_t min_us_{UINT32_MAX};
+  uint32_t max_us_{0};
+  uint64_t total_us_{0};
+};
+
+/// Execution times of a single component, collected when `loop_profiler` is enabled.
+struct ComponentProfile {
+  ExecutionHistogram loop;       ///< Calls of loop().
+  ExecutionHistogram scheduler;  ///< Timeouts, intervals and defers registered by the component.
+  uint32_t setup_us{0};          ///< Duration of setup().
+};
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
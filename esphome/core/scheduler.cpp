@@ -10,6 +10,14 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Maximum number of finished items kept around for reuse. Items only come back to the pool when a timeout has run or
+// an item is cancelled, so what the pool has to cover is the timeouts that are re-armed all the time (debounce and
+// throttle filters, retries, components that poll with set_timeout), usually a handful, rather than the number of
+// scheduled items. Intervals that are never cancelled keep their item and never
+// need the pool. The cap bounds the memory held after a burst, like the many items that finish during boot: beyond
+// it items are freed. 16 items take 2 kB on a 64-bit host and less on 32-bit targets. If item_allocations in
+// get_pool_stats() keeps growing once the device has settled, the churn is higher than the pool.
+static const size_t MAX_POOL_SIZE = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -20,37 +28,54 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // avoid the main thread modifying the list while it is being accessed.
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
-                                std::function<void()> func) {
+                                SchedulerCallback func) {
+  this->set_timeout_(component, name_to_id(name), &name, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout, SchedulerCallback func) {
+  this->set_timeout_(component, id, nullptr, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout_(Component *component, uint32_t id, const std::string *name, uint32_t timeout,
+                                 SchedulerCallback func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (id != NO_ID)
+    this->cancel_item_(component, id, name, SchedulerItem::TIMEOUT);
 
   if (timeout == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
+  ESP_LOGVV(TAG, "set_timeout(id=0x%08" PRIX32 ", timeout=%" PRIu32 ")", id, timeout);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_(std::move(func));
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->name = name != nullptr ? *name : "";
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
-  item->callback = std::move(func);
   item->remove = false;
   this->push_(std::move(item));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, name_to_id(name), &name, SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, id, nullptr, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
-                                 std::function<void()> func) {
+                                 SchedulerCallback func) {
+  this->set_interval_(component, name_to_id(name), &name, interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval, SchedulerCallback func) {
+  this->set_interval_(component, id, nullptr, interval, std::move(func));
+}
+void HOT Scheduler::set_interval_(Component *component, uint32_t id, const std::string *name, uint32_t interval,
+                                  SchedulerCallback func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (id != NO_ID)
+    this->cancel_item_(component, id, name, SchedulerItem::INTERVAL);
 
   if (interval == SCHEDULER_DONT_RUN)
     return;
@@ -60,23 +85,26 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   if (interval != 0)
     offset = (random_uint32() % interval) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
+  ESP_LOGVV(TAG, "set_interval(id=0x%08" PRIX32 ", interval=%" PRIu32 ", offset=%" PRIu32 ")", id, interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_(std::move(func));
   item->component = component;
-  item->name = name;
+  item->id = id;
+  item->name = name != nullptr ? *name : "";
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
   item->last_execution_major = this->millis_major_;
   if (item->last_execution > now)
     item->last_execution_major--;
-  item->callback = std::move(func);
   item->remove = false;
   this->push_(std::move(item));
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+  return this->cancel_item_(component, name_to_id(name), &name, SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, id, nullptr, SchedulerItem::INTERVAL);
 }
 
 struct RetryArgs {
@@ -84,7 +112,7 @@ struct RetryArgs {
   uint8_t retry_countdown;
   uint32_t current_interval;
   Component *component;
-  std::string name;
+  uint32_t timeout_id;
   float backoff_increase_factor;
   Scheduler *scheduler;
 };
@@ -94,7 +122,8 @@ static void retry_handler(const std::shared_ptr<RetryArgs> &args) {
   if (retry_result == RetryResult::DONE || args->retry_countdown <= 0)
     return;
   // second execution of `func` happens after `initial_wait_time`
-  args->scheduler->set_timeout(args->component, args->name, args->current_interval, [args]() { retry_handler(args); });
+  args->scheduler->set_timeout(args->component, args->timeout_id, args->current_interval,
+                               [args]() { retry_handler(args); });
   // backoff_increase_factor applied to third & later executions
   args->current_interval *= args->backoff_increase_factor;
 }
@@ -102,19 +131,25 @@ static void retry_handler(const std::shared_ptr<RetryArgs> &args) {
 void HOT Scheduler::set_retry(Component *component, const std::string &name, uint32_t initial_wait_time,
                               uint8_t max_attempts, std::function<RetryResult(uint8_t)> func,
                               float backoff_increase_factor) {
-  if (!name.empty())
-    this->cancel_retry(component, name);
+  this->set_retry(component, name_to_id(name), initial_wait_time, max_attempts, std::move(func),
+                  backoff_increase_factor);
+}
+void HOT Scheduler::set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                              std::function<RetryResult(uint8_t)> func, float backoff_increase_factor) {
+  const uint32_t timeout_id = retry_timeout_id_(id);
+  this->cancel_timeout(component, timeout_id);
 
   if (initial_wait_time == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%" PRIu32 ", max_attempts=%u, backoff_factor=%0.1f)",
-            name.c_str(), initial_wait_time, max_attempts, backoff_increase_factor);
+  ESP_LOGVV(TAG, "set_retry(id=0x%08" PRIX32 ", initial_wait_time=%" PRIu32 ", max_attempts=%u, backoff_factor=%0.1f)",
+            id, initial_wait_time, max_attempts, backoff_increase_factor);
 
   if (backoff_increase_factor < 0.0001) {
     ESP_LOGE(TAG,
-             "set_retry(name='%s'): backoff_factor cannot be close to zero nor negative (%0.1f). Using 1.0 instead",
-             name.c_str(), backoff_increase_factor);
+             "set_retry(id=0x%08" PRIX32 "): backoff_factor cannot be close to zero nor negative (%0.1f). Using 1.0 "
+             "instead",
+             id, backoff_increase_factor);
     backoff_increase_factor = 1;
   }
 
@@ -123,15 +158,18 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   args->retry_countdown = max_attempts;
   args->current_interval = initial_wait_time;
   args->component = component;
-  args->name = "retry$" + name;
+  args->timeout_id = timeout_id;
   args->backoff_increase_factor = backoff_increase_factor;
   args->scheduler = this;
 
   // First execution of `func` immediately
-  this->set_timeout(component, args->name, 0, [args]() { retry_handler(args); });
+  this->set_timeout(component, timeout_id, 0, [args]() { retry_handler(args); });
 }
 bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
-  return this->cancel_timeout(component, "retry$" + name);
+  return this->cancel_retry(component, name_to_id(name));
+}
+bool HOT Scheduler::cancel_retry(Component *component, uint32_t id) {
+  return this->cancel_timeout(component, retry_timeout_id_(id));
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
@@ -157,12 +195,12 @@ void HOT Scheduler::call() {
     ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu32, this->items_.size(), now);
     while (!this->empty_()) {
       this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
+      auto item = this->pop_raw_();
       this->lock_.unlock();
 
-      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
+      ESP_LOGVV(TAG, "  %s '%s' (0x%08" PRIX32 ") interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32
+                " (%u)",
+                item->get_type_str(), item->name.c_str(), item->id, item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
 
       old_items.push_back(std::move(item));
@@ -171,7 +209,8 @@ void HOT Scheduler::call() {
 
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(old_items);
+      for (auto &item : old_items)
+        this->push_heap_(std::move(item));
     }
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
@@ -183,14 +222,13 @@ void HOT Scheduler::call() {
     std::vector<std::unique_ptr<SchedulerItem>> valid_items;
     while (!this->empty_()) {
       LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
+      valid_items.push_back(this->pop_raw_());
     }
 
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
+      for (auto &item : valid_items)
+        this->push_heap_(std::move(item));
     }
 
     // The following should not happen unless I'm missing something
@@ -217,20 +255,22 @@ void HOT Scheduler::call() {
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
         LockGuard guard{this->lock_};
-        this->pop_raw_();
+        this->recycle_item_(this->pop_raw_());
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+      ESP_LOGVV(TAG,
+                "Running %s '%s' (0x%08" PRIX32 ") with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32
+                ")",
+                item->get_type_str(), item->name.c_str(), item->id, item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
-        WarnIfComponentBlockingGuard guard{item->component};
+        WarnIfComponentBlockingGuard guard{item->component, ExecutionSource::SCHEDULER};
         item->callback();
       }
     }
@@ -239,17 +279,17 @@ void HOT Scheduler::call() {
       this->lock_.lock();
 
       // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
       // Only pop after function call, this ensures we were reachable
       // during the function call and know if we were cancelled.
-      this->pop_raw_();
+      auto item = this->pop_raw_();
 
       this->lock_.unlock();
 
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
         continue;
       }
 
@@ -262,6 +302,9 @@ void HOT Scheduler::call() {
             item->last_execution_major++;
         }
         this->push_(std::move(item));
+      } else {
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -272,11 +315,11 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
-    this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->push_heap_(std::move(it));
   }
   this->to_add_.clear();
 }
@@ -290,31 +333,99 @@ void HOT Scheduler::cleanup_() {
 
     {
       LockGuard guard{this->lock_};
-      this->pop_raw_();
+      this->recycle_item_(this->pop_raw_());
     }
   }
 }
-void HOT Scheduler::pop_raw_() {
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_(SchedulerCallback &&func) {
+  LockGuard guard{this->lock_};
+  std::unique_ptr<SchedulerItem> item;
+  if (this->free_items_.empty()) {
+    item = make_unique<SchedulerItem>();
+    this->item_allocations_++;
+  } else {
+    item = std::move(this->free_items_.back());
+    this->free_items_.pop_back();
+  }
+  if (++this->items_in_use_ > this->items_high_water_mark_)
+    this->items_high_water_mark_ = this->items_in_use_;
+  if (!func.is_inline())
+    this->callback_allocations_++;
+  item->callback = std::move(func);
+  return item;
+}
+// Must be called with `lock_` held.
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  this->items_in_use_--;
+  // Release whatever the callback captured now, not when the item is eventually reused
+  item->callback.reset();
+  if (this->free_items_.size() >= MAX_POOL_SIZE)
+    return;
+  if (this->free_items_.capacity() < MAX_POOL_SIZE)
+    this->free_items_.reserve(MAX_POOL_SIZE);
+  this->free_items_.push_back(std::move(item));
+}
+Scheduler::PoolStats Scheduler::get_pool_stats() {
+  LockGuard guard{this->lock_};
+  return {this->items_in_use_, this->items_high_water_mark_, this->item_allocations_, this->callback_allocations_};
+}
+#ifndef USE_SCHEDULER_INDEXED_HEAP
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  auto item = std::move(this->items_.back());
   this->items_.pop_back();
+  return item;
+}
+void HOT Scheduler::push_heap_(std::unique_ptr<SchedulerItem> item) {
+  this->items_.push_back(std::move(item));
+  std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
 }
+#endif  // USE_SCHEDULER_INDEXED_HEAP
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
   LockGuard guard{this->lock_};
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+  item->heap_index = NOT_IN_HEAP;
+#endif
   this->to_add_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t id, const std::string *name,
+                                 Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
   bool ret = false;
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+  // Cancelling by id can match several items whose names share that id. Removing an item invalidates the range, so
+  // look it up again after each removal.
+  bool removed = true;
+  while (removed) {
+    removed = false;
+    auto range = this->index_.equal_range(index_key_(component, id, type));
+    for (auto it = range.first; it != range.second; ++it) {
+      SchedulerItem *item = it->second;
+      if (item->remove || !item->matches(component, id, name, type))
+        continue;
+      if (item->heap_index == 0) {
+        // The top item might be executing right now, so it is only flagged and popped by call() / cleanup_()
+        to_remove_++;
+        item->remove = true;
+      } else {
+        this->recycle_item_(this->remove_at_(item->heap_index));
+      }
+      ret = removed = true;
+      break;
+    }
+  }
+#else
   for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->matches(component, id, name, type) && !it->remove) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   }
+#endif  // USE_SCHEDULER_INDEXED_HEAP
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->matches(component, id, name, type)) {
       it->remove = true;
       ret = true;
     }
@@ -322,6 +433,79 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+// The indexed heap is a plain binary min-heap where every item remembers its own position. This allows removing
+// arbitrary items in O(log n) instead of flagging them and waiting for them to bubble to the top. Named items are
+// additionally tracked in `index_`, so cancelling does not need to scan all items.
+// All of these must be called with `lock_` held.
+uint32_t Scheduler::index_key_(Component *component, uint32_t id, SchedulerItem::Type type) {
+  auto component_hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component));
+  return (id * 31 + component_hash) * 31 + static_cast<uint32_t>(type);
+}
+void HOT Scheduler::index_erase_(SchedulerItem *item) {
+  if (item->id == NO_ID)
+    return;
+  auto range = this->index_.equal_range(index_key_(item->component, item->id, item->type));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == item) {
+      this->index_.erase(it);
+      return;
+    }
+  }
+}
+void HOT Scheduler::swap_items_(size_t a, size_t b) {
+  std::swap(this->items_[a], this->items_[b]);
+  this->items_[a]->heap_index = a;
+  this->items_[b]->heap_index = b;
+}
+void HOT Scheduler::sift_up_(size_t index) {
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!SchedulerItem::cmp(this->items_[parent], this->items_[index]))
+      break;
+    this->swap_items_(parent, index);
+    index = parent;
+  }
+}
+void HOT Scheduler::sift_down_(size_t index) {
+  const size_t size = this->items_.size();
+  while (true) {
+    size_t first = index;
+    size_t left = 2 * index + 1;
+    size_t right = left + 1;
+    if (left < size && SchedulerItem::cmp(this->items_[first], this->items_[left]))
+      first = left;
+    if (right < size && SchedulerItem::cmp(this->items_[first], this->items_[right]))
+      first = right;
+    if (first == index)
+      return;
+    this->swap_items_(index, first);
+    index = first;
+  }
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::remove_at_(size_t index) {
+  const size_t last = this->items_.size() - 1;
+  if (index != last)
+    this->swap_items_(index, last);
+  auto item = std::move(this->items_.back());
+  this->items_.pop_back();
+  if (index < this->items_.size()) {
+    this->sift_down_(index);
+    this->sift_up_(index);
+  }
+  this->index_erase_(item.get());
+  item->heap_index = NOT_IN_HEAP;
+  return item;
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() { return this->remove_at_(0); }
+void HOT Scheduler::push_heap_(std::unique_ptr<SchedulerItem> item) {
+  item->heap_index = this->items_.size();
+  if (item->id != NO_ID)
+    this->index_.emplace(index_key_(item->component, item->id, item->type), item.get());
+  this->items_.push_back(std::move(item));
+  this->sift_up_(this->items_.size() - 1);
+}
+#endif  // USE_SCHEDULER_INDEXED_HEAP
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -332,6 +516,13 @@ uint32_t Scheduler::millis_() {
   return now;
 }
 
+bool HOT Scheduler::SchedulerItem::matches(Component *component, uint32_t id, const std::string *name,
+                                           Type type) const {
+  if (this->component != component || this->id != id || this->type != type)
+    return false;
+  // Names that hash to the same id are still different items. Items set by id have no name to compare.
+  return name == nullptr || this->name.empty() || this->name == *name;
+}
 bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
                                        const std::unique_ptr<SchedulerItem> &b) {
   // min-heap
@@ -4,22 +4,58 @@
 #include <memory>
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+#include <unordered_map>
+#endif
+
 namespace esphome {
 
 class Component;
 
 class Scheduler {
  public:
-  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  /** Convert a timeout/interval/retry name to the id the scheduler stores.
+   *
+   * Ids are FNV-1 hashes of the name, so `fnv1_hash("name")` can be computed at compile time and passed to the id
+   * overloads, which then never touch the heap. An empty name maps to `NO_ID`, which can never be cancelled.
+   *
+   * Different names can hash to the same id. Items set by name therefore also keep the name, and two names only refer
+   * to the same item if they are equal. Items set by id match any name with that id.
+   */
+  static uint32_t name_to_id(const std::string &name) { return name.empty() ? NO_ID : fnv1_hash(name); }
+  static const uint32_t NO_ID = 0;
+
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, SchedulerCallback func);
+  void set_timeout(Component *component, uint32_t id, uint32_t timeout, SchedulerCallback func);
   bool cancel_timeout(Component *component, const std::string &name);
-  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  bool cancel_timeout(Component *component, uint32_t id);
+  void set_interval(Component *component, const std::string &name, uint32_t interval, SchedulerCallback func);
+  void set_interval(Component *component, uint32_t id, uint32_t interval, SchedulerCallback func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, uint32_t id);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
+  void set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                 std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
+  bool cancel_retry(Component *component, uint32_t id);
+
+  /// Counters of the SchedulerItem pool, for diagnostics.
+  struct PoolStats {
+    /// Items currently scheduled (or pending to be scheduled).
+    uint32_t in_use;
+    /// Highest value `in_use` has reached since boot.
+    uint32_t high_water_mark;
+    /// Items that had to be allocated on the heap because the pool was empty.
+    uint32_t item_allocations;
+    /// Callbacks whose captures did not fit in SchedulerCallback and were moved to the heap.
+    uint32_t callback_allocations;
+  };
+  PoolStats get_pool_stats();
 
   optional<uint32_t> next_schedule_in();
 
@@ -30,6 +66,8 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
+    uint32_t id;
+    /// The name this item was set with, empty if it was set by id.
     std::string name;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
@@ -37,9 +75,13 @@ class Scheduler {
       uint32_t timeout;
     };
     uint32_t last_execution;
-    std::function<void()> callback;
+    SchedulerCallback callback;
     bool remove;
     uint8_t last_execution_major;
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+    /// Position of this item in `items_`, or `NOT_IN_HEAP` while it is pending in `to_add_`.
+    size_t heap_index;
+#endif
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
@@ -50,6 +92,8 @@ class Scheduler {
       return next_exec_major;
     }
 
+    /// Whether this item is the one identified by (component, id, name, type). \p name is nullptr for the id overloads.
+    bool matches(Component *component, uint32_t id, const std::string *name, Type type) const;
     static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
     const char *get_type_str() {
       switch (this->type) {
@@ -63,11 +107,33 @@ class Scheduler {
     }
   };
 
+  /** The id of the timeout that runs the retry `id`.
+   *
+   * The hash continues from the retry's id, so the retry "name" runs as the timeout `fnv1_hash("name$retry")` without
+   * ever building that string, and unnamed retries share one timeout per component.
+   */
+  static uint32_t retry_timeout_id_(uint32_t id) { return fnv1_hash("$retry", id); }
+  void set_timeout_(Component *component, uint32_t id, const std::string *name, uint32_t timeout,
+                    SchedulerCallback func);
+  void set_interval_(Component *component, uint32_t id, const std::string *name, uint32_t interval,
+                     SchedulerCallback func);
+  std::unique_ptr<SchedulerItem> acquire_item_(SchedulerCallback &&func);
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
   uint32_t millis_();
   void cleanup_();
-  void pop_raw_();
+  std::unique_ptr<SchedulerItem> pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  void push_heap_(std::unique_ptr<SchedulerItem> item);
+  bool cancel_item_(Component *component, uint32_t id, const std::string *name, SchedulerItem::Type type);
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+  static const size_t NOT_IN_HEAP = SIZE_MAX;
+  static uint32_t index_key_(Component *component, uint32_t id, SchedulerItem::Type type);
+  void index_erase_(SchedulerItem *item);
+  void sift_up_(size_t index);
+  void sift_down_(size_t index);
+  std::unique_ptr<SchedulerItem> remove_at_(size_t index);
+  void swap_items_(size_t a, size_t b);
+#endif
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -79,6 +145,16 @@ class Scheduler {
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
+  /// Finished items kept for reuse, so that steady-state scheduling does not touch the heap. At most MAX_POOL_SIZE.
+  std::vector<std::unique_ptr<SchedulerItem>> free_items_;
+  uint32_t items_in_use_{0};
+  uint32_t items_high_water_mark_{0};
+  uint32_t item_allocations_{0};
+  uint32_t callback_allocations_{0};
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+  /// Named items currently in `items_`, keyed by a hash of (component, id, type) for O(1) lookup on cancel.
+  std::unordered_multimap<uint32_t, SchedulerItem *> index_;
+#endif
 };
 
 }  // namespace esphome
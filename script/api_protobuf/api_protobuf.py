@@ -176,6 +176,17 @@ class TypeInfo(ABC):
 
     encode_func = None
 
+    @property
+    def field_id_size(self):
+        # size of the varint holding field number and wire type, known at generation time
+        return varint_size(self.number << 3)
+
+    @property
+    def calculate_size_content(self):
+        return f"ProtoSize::{self.size_func}(total_size, {self.field_id_size}, this->{self.field_name});"
+
+    size_func = None
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -218,6 +229,7 @@ class FloatType(TypeInfo):
     default_value = "0.0f"
     decode_32bit = "value.as_float()"
     encode_func = "encode_float"
+    size_func = "add_float_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
@@ -231,6 +243,7 @@ class Int64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int64()"
     encode_func = "encode_int64"
+    size_func = "add_int64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -244,6 +257,7 @@ class UInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint64()"
     encode_func = "encode_uint64"
+    size_func = "add_uint64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
@@ -257,6 +271,7 @@ class Int32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_int32()"
     encode_func = "encode_int32"
+    size_func = "add_int32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRId32, {name});\n'
@@ -270,6 +285,7 @@ class Fixed64Type(TypeInfo):
     default_value = "0"
     decode_64bit = "value.as_fixed64()"
     encode_func = "encode_fixed64"
+    size_func = "add_fixed64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
@@ -283,6 +299,7 @@ class Fixed32Type(TypeInfo):
     default_value = "0"
     decode_32bit = "value.as_fixed32()"
     encode_func = "encode_fixed32"
+    size_func = "add_fixed32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRIu32, {name});\n'
@@ -296,6 +313,7 @@ class BoolType(TypeInfo):
     default_value = "false"
     decode_varint = "value.as_bool()"
     encode_func = "encode_bool"
+    size_func = "add_bool_field"
 
     def dump(self, name):
         o = f"out.append(YESNO({name}));"
@@ -310,6 +328,7 @@ class StringType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "add_string_field"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -336,6 +355,10 @@ class MessageType(TypeInfo):
     def encode_func(self):
         return f"encode_message<{self.cpp_type}>"
 
+    @property
+    def size_func(self):
+        return f"add_message_field<{self.cpp_type}>"
+
     @property
     def decode_length(self):
         return f"value.as_message<{self.cpp_type}>()"
@@ -353,6 +376,7 @@ class BytesType(TypeInfo):
     const_reference_type = "const std::string &"
     decode_length = "value.as_string()"
     encode_func = "encode_string"
+    size_func = "add_string_field"
 
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
@@ -365,6 +389,7 @@ class UInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_uint32()"
     encode_func = "encode_uint32"
+    size_func = "add_uint32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRIu32, {name});\n'
@@ -388,6 +413,10 @@ class EnumType(TypeInfo):
     def encode_func(self):
         return f"encode_enum<{self.cpp_type}>"
 
+    @property
+    def size_func(self):
+        return f"add_enum_field<{self.cpp_type}>"
+
     def dump(self, name):
         o = f"out.append(proto_enum_to_string<{self.cpp_type}>({name}));"
         return o
@@ -425,6 +454,7 @@ class SInt32Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint32()"
     encode_func = "encode_sint32"
+    size_func = "add_sint32_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%" PRId32, {name});\n'
@@ -438,6 +468,7 @@ class SInt64Type(TypeInfo):
     default_value = "0"
     decode_varint = "value.as_sint64()"
     encode_func = "encode_sint64"
+    size_func = "add_sint64_field"
 
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
@@ -526,6 +557,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += "}"
         return o
 
+    @property
+    def calculate_size_content(self):
+        o = f"for (const auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  ProtoSize::{self._ti.size_func}(total_size, {self.field_id_size}, it, true);\n"
+        o += "}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -539,6 +577,14 @@ class RepeatedTypeInfo(TypeInfo):
         pass
 
 
+def varint_size(value):
+    size = 1
+    while value > 0x7F:
+        value >>= 7
+        size += 1
+    return size
+
+
 def build_enum_type(desc):
     name = desc.name
     out = f"enum {name} : uint32_t {{\n"
@@ -569,6 +615,7 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
@@ -579,6 +626,7 @@ def build_message_type(desc):
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -645,6 +693,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if calculate_size:
+        if len(calculate_size) == 1 and len(calculate_size[0]) + len(o) + 3 < 120:
+            o += f" {calculate_size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(calculate_size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -671,6 +731,10 @@ def build_message_type(desc):
     prot += "#endif\n"
     public_content.append(prot)
 
+    id_ = get_opt(desc, pb.id)
+    if id_ is not None:
+        public_content.insert(0, f"static constexpr uint16_t MESSAGE_TYPE = {id_};")
+
     out = f"class {desc.name} : public ProtoMessage {{\n"
     out += " public:\n"
     out += indent("\n".join(public_content)) + "\n"
@@ -0,0 +1,86 @@
+#include "harness.h"
+
+#include "esphome/components/adc/sample_aggregator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::adc;
+
+static const double PI = 3.14159265358979323846;
+static const size_t FRAME_SAMPLES = 256;  // Like the DMA frames of the ADC in continuous mode
+static const float BIAS = 1.65f;          // Mid-supply bias of a current clamp on a 3.3 V ADC
+
+static bool near(double value, double expected, double tolerance) { return std::fabs(value - expected) <= tolerance; }
+
+// `periods` periods of a sine with the given RMS on top of BIAS, sampled 400 times per period (50 Hz at 20 kHz)
+static std::vector<float> biased_sine(double rms, size_t periods) {
+  const size_t period = 400;
+  std::vector<float> samples(period * periods);
+  for (size_t i = 0; i < samples.size(); i++)
+    samples[i] = BIAS + rms * std::sqrt(2.0) * std::sin(2.0 * PI * (i % period) / period);
+  return samples;
+}
+
+static void add_in_frames(SampleAggregator &aggregator, const std::vector<float> &samples) {
+  for (size_t i = 0; i < samples.size(); i += FRAME_SAMPLES)
+    aggregator.add(&samples[i], std::min(FRAME_SAMPLES, samples.size() - i));
+}
+
+static void test_empty_is_nan() {
+  SampleAggregator aggregator;
+  EXPECT(aggregator.count() == 0);
+  for (auto aggregate : {SampleAggregate::MEAN, SampleAggregate::RMS, SampleAggregate::AC_RMS, SampleAggregate::MIN,
+                         SampleAggregate::MAX, SampleAggregate::PEAK_TO_PEAK})
+    EXPECT(std::isnan(aggregator.get(aggregate)));
+}
+
+static void test_aggregates_of_a_sine() {
+  SampleAggregator aggregator;
+  add_in_frames(aggregator, biased_sine(0.5, 10));
+  EXPECT(aggregator.count() == 4000);
+  EXPECT(near(aggregator.mean(), BIAS, 1e-6));
+  EXPECT(near(aggregator.ac_rms(), 0.5, 1e-6));
+  EXPECT(near(aggregator.rms(), std::sqrt(BIAS * BIAS + 0.25), 1e-6));
+  EXPECT(near(aggregator.min(), BIAS - 0.5 * std::sqrt(2.0), 1e-6));
+  EXPECT(near(aggregator.max(), BIAS + 0.5 * std::sqrt(2.0), 1e-6));
+  EXPECT(near(aggregator.get(SampleAggregate::PEAK_TO_PEAK), std::sqrt(2.0), 1e-6));
+}
+
+static void test_reset_starts_a_new_window() {
+  SampleAggregator aggregator;
+  add_in_frames(aggregator, biased_sine(0.5, 1));
+  aggregator.reset();
+  EXPECT(aggregator.count() == 0);
+  EXPECT(std::isnan(aggregator.mean()));
+
+  // The min and max of the previous window must not leak into the next one
+  const float constant[] = {1.0f, 1.0f, 1.0f};
+  aggregator.add(constant, 3);
+  EXPECT(aggregator.min() == 1.0f);
+  EXPECT(aggregator.max() == 1.0f);
+  EXPECT(aggregator.ac_rms() == 0.0f);
+}
+
+// A small AC part on a large bias over ten minutes at 20 kHz. Accumulating the samples in a single float loses the AC
+// part entirely, the aggregator must keep it.
+static void test_long_window_keeps_small_ac_part() {
+  // 16 periods are exactly 25 frames, so repeating them gives the same frames as a continuous signal
+  const std::vector<float> periods = biased_sine(0.010, 16);
+  SampleAggregator aggregator;
+  for (size_t i = 0; i < 12000000 / periods.size(); i++)
+    add_in_frames(aggregator, periods);
+  EXPECT(aggregator.count() == 12000000);
+  EXPECT(near(aggregator.mean(), BIAS, 1e-6));
+  EXPECT(near(aggregator.ac_rms(), 0.010, 1e-6));
+}
+
+int main() {
+  test_empty_is_nan();
+  test_aggregates_of_a_sine();
+  test_reset_starts_a_new_window();
+  test_long_window_keeps_small_ac_part();
+  return host_test::finish("adc_sample_aggregator_test");
+}
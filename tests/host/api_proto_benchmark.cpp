@@ -0,0 +1,96 @@
+#include "harness.h"
+
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/components/api/proto.h"
+
+#include <chrono>
+#include <vector>
+
+// Encoding throughput of a few typical messages. "grow" encodes into a fresh buffer that grows as it is written, as
+// send_message_() did before messages were sized. "sized" reserves calculate_size() bytes first, as it does now.
+//
+//   script/host_test tests/host/api_proto_benchmark.cpp
+
+using namespace esphome;
+using namespace esphome::api;
+
+static const int ITERATIONS = 200000;
+
+template<class C> static double megabytes_per_second(const C &msg, bool sized) {
+  size_t bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++) {
+    std::vector<uint8_t> buffer;
+    if (sized) {
+      uint32_t size = 0;
+      msg.calculate_size(size);
+      buffer.reserve(size);
+    }
+    msg.encode(ProtoWriteBuffer(&buffer));
+    bytes += buffer.size();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return bytes / elapsed.count() / 1e6;
+}
+
+template<class C> static void run(const char *name, const C &msg) {
+  std::vector<uint8_t> buffer;
+  msg.encode(ProtoWriteBuffer(&buffer));
+  uint32_t size = 0;
+  msg.calculate_size(size);
+  EXPECT(size == buffer.size());
+
+  double grow = megabytes_per_second(msg, false);
+  double sized = megabytes_per_second(msg, true);
+  std::printf("%-36s %4zu bytes  grow %7.1f MB/s  sized %7.1f MB/s\n", name, buffer.size(), grow, sized);
+}
+
+int main() {
+  ListEntitiesSensorResponse sensor;
+  sensor.object_id = "living_room_temperature";
+  sensor.key = 0x12345678;
+  sensor.name = "Living Room Temperature";
+  sensor.unique_id = "aabbccddeeff-sensor-living_room_temperature";
+  sensor.icon = "mdi:thermometer";
+  sensor.unit_of_measurement = "°C";
+  sensor.accuracy_decimals = 1;
+  sensor.device_class = "temperature";
+  sensor.state_class = enums::STATE_CLASS_MEASUREMENT;
+  run("ListEntitiesSensorResponse", sensor);
+
+  BluetoothLEAdvertisementResponse advertisement;
+  advertisement.address = 0xA4C1380A0B0CULL;
+  advertisement.name = "ATC_0A0B0C";
+  advertisement.rssi = -67;
+  advertisement.service_uuids = {"0000181a-0000-1000-8000-00805f9b34fb"};
+  advertisement.service_data.resize(1);
+  advertisement.service_data[0].uuid = "0000181a-0000-1000-8000-00805f9b34fb";
+  advertisement.service_data[0].data = std::string(15, '\x5a');
+  advertisement.manufacturer_data.resize(1);
+  advertisement.manufacturer_data[0].uuid = "0x004C";
+  advertisement.manufacturer_data[0].data = std::string(23, '\x02');
+  run("BluetoothLEAdvertisementResponse", advertisement);
+
+  BluetoothLERawAdvertisementsResponse raw;
+  raw.advertisements.resize(16);
+  for (size_t i = 0; i < raw.advertisements.size(); i++) {
+    raw.advertisements[i].address = 0xA4C1380A0B00ULL + i;
+    raw.advertisements[i].rssi = -40 - static_cast<int32_t>(i);
+    raw.advertisements[i].data = std::string(31, static_cast<char>(i));
+  }
+  run("BluetoothLERawAdvertisements (16)", raw);
+
+  HomeassistantServiceResponse service;
+  service.service = "notify.mobile_app_phone";
+  service.data.resize(2);
+  service.data[0].key = "title";
+  service.data[0].value = "Washing machine";
+  service.data[1].key = "message";
+  service.data[1].value = "The laundry is done";
+  service.data_template.resize(1);
+  service.data_template[0].key = "data";
+  service.data_template[0].value = "{{ states('sensor.power') }}";
+  run("HomeassistantServiceResponse", service);
+
+  return host_test::finish("api_proto_benchmark");
+}
@@ -0,0 +1,128 @@
+#include "harness.h"
+
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/components/api/proto.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::api;
+
+// None of the messages in api.proto has a fixed64 field, so this one stands in for them.
+class Fixed64Message : public ProtoMessage {
+ public:
+  uint64_t value{0};
+  uint32_t after{0};
+  void encode(ProtoWriteBuffer buffer) const override {
+    buffer.encode_fixed64(1, this->value);
+    buffer.encode_uint32(2, this->after);
+  }
+  void calculate_size(uint32_t &total_size) const override {
+    ProtoSize::add_fixed64_field(total_size, 1, this->value);
+    ProtoSize::add_uint32_field(total_size, 1, this->after);
+  }
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  void dump_to(std::string &out) const override {}
+#endif
+
+ protected:
+  bool decode_varint(uint32_t field_id, ProtoVarInt value) override {
+    if (field_id != 2)
+      return false;
+    this->after = value.as_uint32();
+    return true;
+  }
+  bool decode_64bit(uint32_t field_id, Proto64Bit value) override {
+    if (field_id != 1)
+      return false;
+    this->value = value.as_fixed64();
+    return true;
+  }
+};
+
+template<class C> static std::vector<uint8_t> encode(const C &msg) {
+  std::vector<uint8_t> buffer;
+  msg.encode(ProtoWriteBuffer(&buffer));
+  uint32_t size = 0;
+  msg.calculate_size(size);
+  EXPECT(size == buffer.size());
+  return buffer;
+}
+
+static void test_fixed64_uses_wire_type_1() {
+  Fixed64Message msg;
+  msg.value = 0x0102030405060708ULL;
+  msg.after = 42;
+  auto buffer = encode(msg);
+  EXPECT((buffer == std::vector<uint8_t>{0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x10, 42}));
+
+  Fixed64Message decoded;
+  decoded.decode(buffer.data(), buffer.size());
+  EXPECT(decoded.value == msg.value);
+  // With the wrong wire type the decoder lost its place and never got to the next field
+  EXPECT(decoded.after == 42);
+}
+
+static void test_repeated_empty_strings_are_kept() {
+  ExecuteServiceArgument msg;
+  msg.string_array = {"first", "", "third"};
+  auto buffer = encode(msg);
+
+  ExecuteServiceArgument decoded;
+  decoded.decode(buffer.data(), buffer.size());
+  EXPECT(decoded.string_array == msg.string_array);
+}
+
+static void test_repeated_zero_floats_are_kept() {
+  ExecuteServiceArgument msg;
+  msg.float_array = {1.5f, 0.0f, -2.25f};
+  auto buffer = encode(msg);
+
+  ExecuteServiceArgument decoded;
+  decoded.decode(buffer.data(), buffer.size());
+  EXPECT(decoded.float_array == msg.float_array);
+}
+
+static void test_default_values_are_not_encoded() {
+  ExecuteServiceArgument msg;
+  EXPECT(encode(msg).empty());
+
+  msg.float_ = 0.5f;
+  msg.string_ = "x";
+  auto buffer = encode(msg);
+  ExecuteServiceArgument decoded;
+  decoded.decode(buffer.data(), buffer.size());
+  EXPECT(decoded.float_ == 0.5f);
+  EXPECT(decoded.string_ == "x");
+}
+
+static void test_nested_messages() {
+  HomeassistantServiceResponse msg;
+  msg.service = "light.turn_on";
+  msg.data.resize(2);
+  msg.data[0].key = "entity_id";
+  msg.data[0].value = "light.kitchen";
+  msg.data[1].key = "brightness";
+  msg.data[1].value = "";
+  auto buffer = encode(msg);
+  // service (2 + 13), data[0] (2 + 2 + 9 + 2 + 13), data[1] (2 + 2 + 10, the empty value is left out)
+  EXPECT(buffer.size() == 57);
+
+  HomeassistantServiceResponse decoded;
+  decoded.decode(buffer.data(), buffer.size());
+  EXPECT(decoded.service == msg.service);
+  EXPECT(decoded.data.size() == 2);
+  EXPECT(decoded.data[0].key == "entity_id");
+  EXPECT(decoded.data[0].value == "light.kitchen");
+  EXPECT(decoded.data[1].key == "brightness");
+  EXPECT(decoded.data[1].value.empty());
+}
+
+int main() {
+  test_fixed64_uses_wire_type_1();
+  test_repeated_empty_strings_are_kept();
+  test_repeated_zero_floats_are_kept();
+  test_default_values_are_not_encoded();
+  test_nested_messages();
+  return host_test::finish("api_proto_test");
+}
@@ -0,0 +1,50 @@
+#include "harness.h"
+
+#include "esphome/core/helpers.h"
+
+#include <vector>
+
+using namespace esphome;
+
+static void test_callbacks_run_in_order() {
+  CallbackManager<void(int)> manager;
+  std::vector<int> calls;
+  for (int i = 0; i < 5; i++)
+    manager.add([&calls, i](int value) { calls.push_back(i * 10 + value); });
+  EXPECT(manager.size() == 5);
+  manager.call(1);
+  EXPECT((calls == std::vector<int>{1, 11, 21, 31, 41}));
+}
+
+static void test_array_grows_geometrically() {
+  CallbackManager<void()> manager;
+  const uint32_t before = get_callback_stats().array_allocations;
+  manager.add([]() {});
+  EXPECT(get_callback_stats().array_allocations == before + 1);
+  manager.add([]() {});
+  EXPECT(get_callback_stats().array_allocations == before + 2);
+  // 1, 2, 4, ..., 128
+  for (int i = 2; i < 100; i++)
+    manager.add([]() {});
+  EXPECT(get_callback_stats().array_allocations == before + 8);
+}
+
+static void test_large_captures_are_counted() {
+  CallbackManager<void()> manager;
+  const CallbackStats before = get_callback_stats();
+  int a = 0, b = 0, c = 0, d = 0, e = 0;
+  manager.add([&a]() { a++; });
+  manager.add([&a, &b, &c, &d, &e]() { a += b + c + d + e; });
+  CallbackStats after = get_callback_stats();
+  EXPECT(after.callbacks == before.callbacks + 2);
+  EXPECT(after.capture_allocations == before.capture_allocations + 1);
+  manager.call();
+  EXPECT(a == 1);
+}
+
+int main() {
+  test_callbacks_run_in_order();
+  test_array_grows_geometrically();
+  test_large_captures_are_counted();
+  return host_test::finish("callback_manager_test");
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+// Stands in for the generated defines.h when building the host tests in tests/host, which only need the core and
+// none of the optional components. See script/host_test.
+
+#include "esphome/core/macros.h"
+
+// Informative flags
+#define ESPHOME_BOARD "host"
+#define ESPHOME_VARIANT "host"
+
+#define USE_ESPHOME_HOST_MAC_ADDRESS \
+  { 0x06, 0x00, 0x00, 0x00, 0x00, 0x01 }
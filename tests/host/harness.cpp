@@ -0,0 +1,47 @@
+#include "harness.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cstdarg>
+#include <cstdlib>
+
+namespace esphome {
+
+namespace host_test {
+
+uint32_t now = 0;
+int failures = 0;
+
+int finish(const char *name) {
+  if (failures == 0) {
+    std::printf("%s: OK\n", name);
+    return EXIT_SUCCESS;
+  }
+  std::printf("%s: %d check(s) failed\n", name, failures);
+  return EXIT_FAILURE;
+}
+
+}  // namespace host_test
+
+// The host platform's HAL (esphome/components/host/core.cpp) also provides main(), so the tests bring their own.
+uint32_t millis() { return host_test::now; }
+uint32_t micros() { return host_test::now * 1000U; }
+void delay(uint32_t ms) { host_test::now += ms; }
+void yield() {}
+void arch_feed_wdt() {}
+void arch_restart() { std::abort(); }
+
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  std::printf("[%s:%d]: ", tag, line);
+  std::vprintf(format, args);
+  std::printf("\n");
+}
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list arg;
+  va_start(arg, format);
+  esp_log_vprintf_(level, tag, line, format, arg);
+  va_end(arg);
+}
+
+}  // namespace esphome
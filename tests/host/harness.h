@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+// Helpers shared by the host tests and benchmarks in this directory. See script/host_test.
+
+namespace esphome {
+namespace host_test {
+
+/// The time millis() returns, in ms. Tests move it forward by hand to run the scheduler deterministically.
+extern uint32_t now;
+
+/// Number of failed EXPECT() checks so far.
+extern int failures;
+
+/// Print a summary and return the exit code for main().
+int finish(const char *name);
+
+}  // namespace host_test
+}  // namespace esphome
+
+#define EXPECT(condition) \
+  do { \
+    if (!(condition)) { \
+      std::printf("%s:%d: expected %s\n", __FILE__, __LINE__, #condition); \
+      esphome::host_test::failures++; \
+    } \
+  } while (false)
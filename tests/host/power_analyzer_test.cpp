@@ -0,0 +1,121 @@
+#include "harness.h"
+
+#include "esphome/components/voltage_sampler/power_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::voltage_sampler;
+
+static const double PI = 3.14159265358979323846;
+static const size_t SAMPLE_RATE = 20000;
+static const size_t BLOCK_SAMPLES = 256;  // Like the DMA frames of the ADC in continuous mode
+
+// 50 Hz mains on the ADC pins, one second of it
+static const double VOLTAGE_BIAS = 1.65;
+static const double VOLTAGE_RMS = 1.0;
+static const double CURRENT_BIAS = 1.6;
+static const double CURRENT_RMS = 0.020;
+static const double CURRENT_LAG = PI / 3;  // 60 degrees
+static const double THIRD_HARMONIC_RMS = 0.005;
+
+static bool near(double value, double expected, double tolerance) { return std::fabs(value - expected) <= tolerance; }
+
+struct Waveforms {
+  std::vector<float> current;
+  std::vector<float> voltage;
+};
+
+static Waveforms mains(size_t samples) {
+  Waveforms waveforms;
+  for (size_t i = 0; i < samples; i++) {
+    const double phase = 2.0 * PI * 50.0 * i / SAMPLE_RATE;
+    waveforms.voltage.push_back(VOLTAGE_BIAS + VOLTAGE_RMS * std::sqrt(2.0) * std::sin(phase));
+    waveforms.current.push_back(CURRENT_BIAS + CURRENT_RMS * std::sqrt(2.0) * std::sin(phase - CURRENT_LAG) +
+                                THIRD_HARMONIC_RMS * std::sqrt(2.0) * std::sin(3.0 * phase));
+  }
+  return waveforms;
+}
+
+static void add_in_blocks(PowerAnalyzer &analyzer, const Waveforms &waveforms, bool with_voltage) {
+  for (size_t i = 0; i < waveforms.current.size(); i += BLOCK_SAMPLES) {
+    const size_t count = std::min(BLOCK_SAMPLES, waveforms.current.size() - i);
+    if (with_voltage) {
+      analyzer.add(&waveforms.current[i], &waveforms.voltage[i], count);
+    } else {
+      analyzer.add(&waveforms.current[i], count);
+    }
+  }
+}
+
+static void test_empty_window_is_nan() {
+  PowerAnalyzer analyzer;
+  PowerMeasurement measurement = analyzer.finish();
+  EXPECT(measurement.samples == 0);
+  EXPECT(std::isnan(measurement.current_offset));
+  EXPECT(std::isnan(measurement.current_rms));
+  EXPECT(std::isnan(measurement.real_power));
+  EXPECT(std::isnan(measurement.power_factor));
+}
+
+// The third harmonic adds to the current RMS and so to the apparent power, but not to the real power, since the
+// voltage has no third harmonic
+static void test_power_with_lagging_current_and_third_harmonic() {
+  const double current_rms = std::sqrt(CURRENT_RMS * CURRENT_RMS + THIRD_HARMONIC_RMS * THIRD_HARMONIC_RMS);
+  const double real_power = VOLTAGE_RMS * CURRENT_RMS * std::cos(CURRENT_LAG);
+  const double apparent_power = VOLTAGE_RMS * current_rms;
+
+  const Waveforms waveforms = mains(SAMPLE_RATE);
+  PowerAnalyzer analyzer;
+  // The first window sums relative to its first samples, the next ones relative to the tracked offsets
+  for (int window = 0; window < 3; window++) {
+    add_in_blocks(analyzer, waveforms, true);
+    EXPECT(analyzer.count() == SAMPLE_RATE);
+    PowerMeasurement measurement = analyzer.finish();
+    EXPECT(analyzer.count() == 0);
+    EXPECT(measurement.samples == SAMPLE_RATE);
+    EXPECT(near(measurement.current_offset, CURRENT_BIAS, 1e-6));
+    EXPECT(near(measurement.voltage_offset, VOLTAGE_BIAS, 1e-6));
+    EXPECT(near(measurement.current_rms, current_rms, 1e-6));
+    EXPECT(near(measurement.voltage_rms, VOLTAGE_RMS, 1e-6));
+    EXPECT(near(measurement.real_power, real_power, 1e-6));
+    EXPECT(near(measurement.apparent_power, apparent_power, 1e-6));
+    EXPECT(near(measurement.power_factor, real_power / apparent_power, 1e-5));
+  }
+}
+
+static void test_current_only() {
+  const Waveforms waveforms = mains(SAMPLE_RATE);
+  PowerAnalyzer analyzer;
+  add_in_blocks(analyzer, waveforms, false);
+  PowerMeasurement measurement = analyzer.finish();
+  EXPECT(near(measurement.current_offset, CURRENT_BIAS, 1e-6));
+  EXPECT(near(measurement.current_rms, std::sqrt(CURRENT_RMS * CURRENT_RMS + THIRD_HARMONIC_RMS * THIRD_HARMONIC_RMS),
+              1e-6));
+  EXPECT(std::isnan(measurement.voltage_offset));
+  EXPECT(std::isnan(measurement.voltage_rms));
+  EXPECT(std::isnan(measurement.real_power));
+  EXPECT(std::isnan(measurement.apparent_power));
+  EXPECT(std::isnan(measurement.power_factor));
+}
+
+static void test_no_current_has_no_power_factor() {
+  const std::vector<float> current(BLOCK_SAMPLES, 1.6f);
+  const Waveforms waveforms = mains(BLOCK_SAMPLES);
+  PowerAnalyzer analyzer;
+  analyzer.add(current.data(), waveforms.voltage.data(), BLOCK_SAMPLES);
+  PowerMeasurement measurement = analyzer.finish();
+  EXPECT(measurement.current_rms == 0.0f);
+  EXPECT(measurement.apparent_power == 0.0f);
+  EXPECT(std::isnan(measurement.power_factor));
+}
+
+int main() {
+  test_empty_window_is_nan();
+  test_power_with_lagging_current_and_third_harmonic();
+  test_current_only();
+  test_no_current_has_no_power_factor();
+  return host_test::finish("power_analyzer_test");
+}
@@ -0,0 +1,61 @@
+#include "harness.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/scheduler.h"
+
+#include <chrono>
+
+// Cost of re-arming named timeouts, and of a call() with nothing due, with n timeouts already scheduled. Build it
+// once per scheduler backend to compare them:
+//
+//   script/host_test tests/host/scheduler_benchmark.cpp
+//   CXXFLAGS=-DUSE_SCHEDULER_INDEXED_HEAP script/host_test tests/host/scheduler_benchmark.cpp
+
+using namespace esphome;
+
+static const int ITERATIONS = 20000;
+static const uint32_t REARMED_ID = 0xFFFFFFFF;
+
+template<typename F> static double nanoseconds_per_call(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++)
+    f(i);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ITERATIONS;
+}
+
+static void run(uint32_t items) {
+  Scheduler scheduler;
+  Component component;
+  for (uint32_t i = 0; i < items; i++)
+    scheduler.set_timeout(&component, i + 1, 60000 + i, []() {});
+  scheduler.call();
+
+  // Like a debounce filter that sees a new value every loop iteration
+  double rearm_one = nanoseconds_per_call([&](int i) {
+    scheduler.set_timeout(&component, REARMED_ID, 1000, []() {});
+    scheduler.call();
+  });
+  // Like many filters that each see a new value now and then
+  double rearm_any = nanoseconds_per_call([&](int i) {
+    uint32_t id = i % items + 1;
+    scheduler.cancel_timeout(&component, id);
+    scheduler.set_timeout(&component, id, 60000, []() {});
+    scheduler.call();
+  });
+  double idle = nanoseconds_per_call([&](int i) { scheduler.call(); });
+
+  std::printf("%5u items  re-arm one %8.1f ns  cancel and re-arm any %8.1f ns  idle call() %5.1f ns\n", items,
+              rearm_one, rearm_any, idle);
+}
+
+int main() {
+#ifdef USE_SCHEDULER_INDEXED_HEAP
+  std::printf("scheduler backend: indexed_heap\n");
+#else
+  std::printf("scheduler backend: heap\n");
+#endif
+  for (uint32_t items : {10, 100, 1000, 5000})
+    run(items);
+  return host_test::finish("scheduler_benchmark");
+}
@@ -0,0 +1,131 @@
+#include "harness.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+// Two names with the same 32-bit FNV-1 hash
+static const char *const COLLIDING_A = "timer_66358";
+static const char *const COLLIDING_B = "timer_749130";
+
+static std::vector<std::string> ran;
+
+// Advance the clock by ms and return the callbacks that ran, in order
+static std::vector<std::string> run(Scheduler &scheduler, uint32_t ms) {
+  ran.clear();
+  host_test::now += ms;
+  scheduler.call();
+  return ran;
+}
+
+static SchedulerCallback record(const char *name) {
+  return [name]() { ran.emplace_back(name); };
+}
+
+static void test_colliding_names_are_different_items() {
+  EXPECT(fnv1_hash(COLLIDING_A) == fnv1_hash(COLLIDING_B));
+  Scheduler scheduler;
+  Component component;
+
+  // Setting one must not replace the other
+  scheduler.set_timeout(&component, COLLIDING_A, 10, record("a"));
+  scheduler.set_timeout(&component, COLLIDING_B, 10, record("b"));
+  EXPECT(run(scheduler, 10).size() == 2);
+
+  // Cancelling one must not cancel the other
+  scheduler.set_timeout(&component, COLLIDING_A, 10, record("a"));
+  scheduler.set_timeout(&component, COLLIDING_B, 10, record("b"));
+  EXPECT(scheduler.cancel_timeout(&component, COLLIDING_A));
+  EXPECT((run(scheduler, 10) == std::vector<std::string>{"b"}));
+
+  // Also once they have moved from the pending list into the heap
+  scheduler.set_timeout(&component, COLLIDING_A, 10, record("a"));
+  scheduler.set_timeout(&component, COLLIDING_B, 20, record("b"));
+  scheduler.set_timeout(&component, "first", 5, record("first"));
+  scheduler.process_to_add();
+  EXPECT(scheduler.cancel_timeout(&component, COLLIDING_B));
+  EXPECT(!scheduler.cancel_timeout(&component, COLLIDING_B));
+  EXPECT((run(scheduler, 20) == std::vector<std::string>{"first", "a"}));
+}
+
+static void test_id_and_name_refer_to_the_same_item() {
+  Scheduler scheduler;
+  Component component;
+
+  scheduler.set_timeout(&component, fnv1_hash("update"), 10, record("id"));
+  scheduler.set_timeout(&component, "update", 10, record("name"));
+  EXPECT((run(scheduler, 10) == std::vector<std::string>{"name"}));
+
+  scheduler.set_timeout(&component, "update", 10, record("name"));
+  EXPECT(scheduler.cancel_timeout(&component, fnv1_hash("update")));
+  EXPECT(run(scheduler, 10).empty());
+}
+
+static void test_names_are_per_component_and_type() {
+  Scheduler scheduler;
+  Component first, second;
+
+  scheduler.set_timeout(&first, "name", 10, record("first"));
+  scheduler.set_timeout(&second, "name", 10, record("second"));
+  EXPECT(!scheduler.cancel_interval(&first, "name"));
+  EXPECT(run(scheduler, 10).size() == 2);
+}
+
+static void test_unnamed_items_are_never_replaced() {
+  Scheduler scheduler;
+  Component component;
+
+  scheduler.set_timeout(&component, "", 10, record("a"));
+  scheduler.set_timeout(&component, "", 10, record("b"));
+  EXPECT(run(scheduler, 10).size() == 2);
+}
+
+static void test_retries_by_name_and_id() {
+  Scheduler scheduler;
+  Component component;
+  int attempts = 0;
+  auto attempt = [&attempts](uint8_t) {
+    attempts++;
+    return RetryResult::RETRY;
+  };
+
+  scheduler.set_retry(&component, "connect", 10, 5, attempt);
+  run(scheduler, 0);
+  EXPECT(attempts == 1);
+  // A retry is not a timeout of the same name
+  EXPECT(!scheduler.cancel_timeout(&component, "connect"));
+  // The hash of a name refers to the same retry as the name
+  EXPECT(scheduler.cancel_retry(&component, fnv1_hash("connect")));
+  run(scheduler, 10);
+  EXPECT(attempts == 1);
+
+  scheduler.set_retry(&component, fnv1_hash("connect"), 10, 5, attempt);
+  run(scheduler, 0);
+  run(scheduler, 10);
+  EXPECT(attempts == 3);
+  EXPECT(scheduler.cancel_retry(&component, "connect"));
+  run(scheduler, 10);
+  EXPECT(attempts == 3);
+
+  // An unnamed retry replaces the previous unnamed retry of the component
+  scheduler.set_retry(&component, Scheduler::NO_ID, 10, 5, attempt);
+  scheduler.set_retry(&component, "", 10, 5, attempt);
+  run(scheduler, 0);
+  EXPECT(attempts == 4);
+  EXPECT(scheduler.cancel_retry(&component, Scheduler::NO_ID));
+  EXPECT(!scheduler.cancel_retry(&component, ""));
+}
+
+int main() {
+  test_colliding_names_are_different_items();
+  test_id_and_name_refer_to_the_same_item();
+  test_names_are_per_component_and_type();
+  test_unnamed_items_are_never_replaced();
+  test_retries_by_name_and_id();
+  return host_test::finish("scheduler_test");
+}
@@ -0,0 +1,180 @@
+#include "harness.h"
+
+#include "esphome/components/sensor/window_statistics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Cost per value of the median, quantile and min/max sensor filters, comparing the previous implementations, which
+// copied and sorted or scanned the whole window for every result, with the windows in window_statistics.h. Also
+// checks that both give the same results:
+//
+//   script/host_test tests/host/sensor_filter_benchmark.cpp
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+static const size_t VALUES = 200000;
+static const float QUANTILE = 0.9f;
+
+/// The window of the previous filters: a deque whose non-NaN values are copied and sorted for every result.
+class RescannedWindow {
+ public:
+  explicit RescannedWindow(size_t window_size) : window_size_(window_size) {}
+
+  void push(float value) {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+  }
+
+  float median() const {
+    std::vector<float> sorted = this->sorted_();
+    size_t size = sorted.size();
+    if (size == 0)
+      return NAN;
+    if (size % 2)
+      return sorted[size / 2];
+    return (sorted[size / 2] + sorted[(size / 2) - 1]) / 2.0f;
+  }
+
+  float quantile(float quantile) const {
+    std::vector<float> sorted = this->sorted_();
+    size_t size = sorted.size();
+    if (size == 0)
+      return NAN;
+    size_t position = ceilf(size * quantile) - 1;
+    return sorted[position];
+  }
+
+  float min() const {
+    float min = NAN;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        min = std::isnan(min) ? v : std::min(min, v);
+    }
+    return min;
+  }
+
+  float max() const {
+    float max = NAN;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        max = std::isnan(max) ? v : std::max(max, v);
+    }
+    return max;
+  }
+
+ protected:
+  std::vector<float> sorted_() const {
+    std::vector<float> sorted;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        sorted.push_back(v);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+
+  std::deque<float> queue_;
+  size_t window_size_;
+};
+
+static float median(const SortedWindow &window) {
+  size_t size = window.size();
+  if (size == 0)
+    return NAN;
+  if (size % 2)
+    return window.get(size / 2);
+  return (window.get(size / 2) + window.get((size / 2) - 1)) / 2.0f;
+}
+
+static float quantile(const SortedWindow &window, float quantile) {
+  size_t size = window.size();
+  if (size == 0)
+    return NAN;
+  size_t position = std::max(ceilf(size * quantile), 1.0f) - 1;
+  return window.get(position);
+}
+
+static bool same_results(const std::vector<float> &a, const std::vector<float> &b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+/// Runs `f` for every value, collecting what it returns, and reports the time per value in ns.
+template<typename F> static double nanoseconds_per_value(const std::vector<float> &values, std::vector<float> &results,
+                                                         F &&f) {
+  results.clear();
+  results.reserve(values.size());
+  auto start = std::chrono::steady_clock::now();
+  for (float value : values)
+    results.push_back(f(value));
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / values.size();
+}
+
+static void run(size_t window_size, const std::vector<float> &values) {
+  std::vector<float> old_results, new_results;
+
+  RescannedWindow old_median(window_size);
+  SortedWindow new_median(window_size);
+  double old_median_ns = nanoseconds_per_value(values, old_results, [&](float value) {
+    old_median.push(value);
+    return old_median.median();
+  });
+  double new_median_ns = nanoseconds_per_value(values, new_results, [&](float value) {
+    new_median.push(value);
+    return median(new_median);
+  });
+  EXPECT(same_results(old_results, new_results));
+
+  RescannedWindow old_quantile(window_size);
+  SortedWindow new_quantile(window_size);
+  double old_quantile_ns = nanoseconds_per_value(values, old_results, [&](float value) {
+    old_quantile.push(value);
+    return old_quantile.quantile(QUANTILE);
+  });
+  double new_quantile_ns = nanoseconds_per_value(values, new_results, [&](float value) {
+    new_quantile.push(value);
+    return quantile(new_quantile, QUANTILE);
+  });
+  EXPECT(same_results(old_results, new_results));
+
+  RescannedWindow old_extremum(window_size);
+  ExtremumWindow<std::less<float>> new_min(window_size);
+  ExtremumWindow<std::greater<float>> new_max(window_size);
+  double old_extremum_ns = nanoseconds_per_value(values, old_results, [&](float value) {
+    old_extremum.push(value);
+    return old_extremum.min() + old_extremum.max();
+  });
+  double new_extremum_ns = nanoseconds_per_value(values, new_results, [&](float value) {
+    new_min.push(value);
+    new_max.push(value);
+    return new_min.get() + new_max.get();
+  });
+  EXPECT(same_results(old_results, new_results));
+
+  std::printf("window %3zu  median %8.1f -> %6.1f ns  quantile %8.1f -> %6.1f ns  min+max %6.1f -> %5.1f ns\n",
+              window_size, old_median_ns, new_median_ns, old_quantile_ns, new_quantile_ns, old_extremum_ns,
+              new_extremum_ns);
+}
+
+int main() {
+  // A noisy signal with occasional NaN values, like a sensor that sometimes fails to read
+  std::mt19937 rng(1);
+  std::normal_distribution<float> noise(20.0f, 2.0f);
+  std::bernoulli_distribution missing(0.02);
+  std::vector<float> values(VALUES);
+  for (float &value : values)
+    value = missing(rng) ? NAN : noise(rng);
+
+  for (size_t window_size : {5, 15, 100, 500})
+    run(window_size, values);
+  return host_test::finish("sensor_filter_benchmark");
+}
@@ -0,0 +1,61 @@
+from esphome.components.logger import tokenizer
+
+
+def test_build_dictionary__tag_per_file(tmp_path):
+    component = tmp_path / "sensor"
+    component.mkdir()
+    (component / "sensor.cpp").write_text(
+        'static const char *const TAG = "sensor";\n'
+        'void a() { ESP_LOGD(TAG, "Publishing state %d", 1); }\n'
+    )
+    (component / "filter.cpp").write_text(
+        'static const char *const TAG = "sensor.filter";\n'
+        'void b() { ESP_LOGD(TAG, "Filter %d", 2); }\n'
+    )
+
+    tokens = tokenizer.build_dictionary(
+        [component / "filter.cpp", component / "sensor.cpp"], 7
+    )
+
+    assert sorted(tokens.values()) == [
+        (b"sensor", b"Publishing state %d"),
+        (b"sensor.filter", b"Filter %d"),
+    ]
+    assert tokenizer.token(b"sensor", b"Publishing state %d") in tokens
+
+
+def test_build_dictionary__tag_from_header(tmp_path):
+    component = tmp_path / "api"
+    component.mkdir()
+    (component / "api.h").write_text('static const char *const TAG = "api";\n')
+    (component / "api.cpp").write_text(
+        'static const char *const TAG = "api.connection";\n'
+    )
+    (component / "api_impl.cpp").write_text(
+        '#include "api.h"\nvoid a() { ESP_LOGI(TAG, "Connected"); }\n'
+    )
+    (component / "other.cpp").write_text('void b() { ESP_LOGI(TAG, "Unknown"); }\n')
+
+    tokens = tokenizer.build_dictionary(sorted(component.iterdir()), 7)
+
+    # TAG is ambiguous in the directory, so other.cpp is left to send text
+    assert list(tokens.values()) == [(b"api", b"Connected")]
+
+
+def test_build_dictionary__tag_from_directory(tmp_path):
+    component = tmp_path / "wifi"
+    component.mkdir()
+    (component / "wifi.cpp").write_text(
+        'static const char *const TAG = "wifi";\n'
+        'void a() { ESP_LOGW(TAG, "Disconnected"); }\n'
+    )
+    (component / "wifi_esp32.cpp").write_text(
+        'void b() { ESP_LOGV(TAG, "Scan %s", "done"); }\n'
+    )
+
+    tokens = tokenizer.build_dictionary(sorted(component.iterdir()), 7)
+
+    assert sorted(tokens.values()) == [
+        (b"wifi", b"Disconnected"),
+        (b"wifi", b"Scan %s"),
+    ]